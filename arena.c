@@ -0,0 +1,57 @@
+#include "arena.h"
+#include <stdlib.h>
+
+#define ARENA_ALIGNMENT sizeof(void*)
+
+typedef struct ArenaChunk {
+    struct ArenaChunk* next;
+    size_t size;
+    size_t used;
+    char data[];
+} ArenaChunk;
+
+struct Arena {
+    ArenaChunk* chunks;     // Newest first; allocations come from the head
+    size_t chunk_size;
+};
+
+Arena* create_arena(size_t chunk_size) {
+    Arena* arena = calloc(1, sizeof(Arena));
+    if (!arena) return NULL;
+
+    arena->chunk_size = chunk_size ? chunk_size : ARENA_DEFAULT_CHUNK_SIZE;
+    return arena;
+}
+
+void free_arena(Arena* arena) {
+    if (!arena) return;
+
+    ArenaChunk* chunk = arena->chunks;
+    while (chunk) {
+        ArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+
+    ArenaChunk* chunk = arena->chunks;
+    if (!chunk || chunk->size - chunk->used < size) {
+        // Oversized requests get a chunk of their own
+        size_t chunk_size = size > arena->chunk_size ? size : arena->chunk_size;
+        chunk = malloc(sizeof(ArenaChunk) + chunk_size);
+        if (!chunk) return NULL;
+
+        chunk->size = chunk_size;
+        chunk->used = 0;
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+    }
+
+    void* ptr = chunk->data + chunk->used;
+    chunk->used += size;
+    return ptr;
+}
@@ -0,0 +1,18 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+
+// Bump allocator for data that lives as long as its owner. Allocations
+// are carved out of large chunks, never move and are only released all
+// together by free_arena. Not thread safe; callers lock around it.
+typedef struct Arena Arena;
+
+// Function declarations
+Arena* create_arena(size_t chunk_size);
+void free_arena(Arena* arena);
+void* arena_alloc(Arena* arena, size_t size);
+
+#endif // ARENA_H
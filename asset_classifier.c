@@ -0,0 +1,248 @@
+#include "asset_classifier.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define SYMBOL_OTHER    0   // Any character that appears in no pattern
+#define SYMBOL_BOUNDARY 1   // Virtual symbol fed before the first character of a word
+
+static const struct {
+    const char* name;       // As written in config.txt
+    const char* label;      // Table column heading
+    unsigned int bit;
+} g_classes[ASSET_CLASS_COUNT] = {
+    { "windows", "Win", ASSET_WINDOWS },
+    { "linux",   "Lin", ASSET_LINUX },
+    { "macos",   "Mac", ASSET_MACOS },
+    { "x64",     "x64", ASSET_X64 },
+    { "arm64",   "ARM", ASSET_ARM64 },
+};
+
+// Patterns starting with a letter or digit only match at the start of a word,
+// so "win64" matches "tool-win64.zip" but not "tool-darwin.tar.gz". Bare
+// "win" needs a separator after it too, or "wine", "winget" and "winter"
+// would count as Windows.
+static const char* g_default_patterns[] = {
+    "windows:windows", "windows:win32", "windows:win64", "windows:win-", "windows:win_", "windows:win.",
+    "windows:msvc", "windows:mingw", "windows:.exe", "windows:.msi",
+    "linux:linux", "linux:musl", "linux:.deb", "linux:.rpm", "linux:.appimage",
+    "macos:macos", "macos:darwin", "macos:osx", "macos:apple", "macos:.dmg", "macos:.pkg",
+    "x64:x64", "x64:x86_64", "x64:x86-64", "x64:amd64", "x64:win64",
+    "arm64:arm64", "arm64:aarch64",
+};
+
+// Aho-Corasick automaton with the failure links folded into a full
+// transition table, so scanning is one table lookup per character
+typedef struct {
+    int* delta;                 // delta[state * symbol_count + symbol] -> next state
+    unsigned int* output;       // ASSET_* bits of every pattern ending in a state
+    int state_count;
+    int symbol_count;
+    unsigned char symbols[256]; // Character -> symbol, case-folded
+    bool word[256];             // Letters and digits
+} Automaton;
+
+static Automaton g_automaton;
+
+// Split "platform:pattern"; returns the platform's bit or 0
+static unsigned int parse_pattern(const char* spec, const char** pattern) {
+    const char* colon = strchr(spec, ':');
+    if (!colon || colon[1] == '\0') return 0;
+
+    for (int i = 0; i < ASSET_CLASS_COUNT; i++) {
+        size_t len = strlen(g_classes[i].name);
+        if ((size_t)(colon - spec) == len && strncmp(spec, g_classes[i].name, len) == 0) {
+            *pattern = colon + 1;
+            return g_classes[i].bit;
+        }
+    }
+    return 0;
+}
+
+// Give every character of a pattern a symbol; returns the number of
+// symbols the pattern compiles to, counting word boundaries
+static int assign_symbols(Automaton* a, const char* pattern) {
+    int length = 0;
+    bool in_word = false;
+
+    for (const unsigned char* p = (const unsigned char*)pattern; *p; p++) {
+        unsigned char c = (unsigned char)tolower(*p);
+        if (a->symbols[c] == SYMBOL_OTHER) {
+            if (a->symbol_count == 256) return -1;
+            a->symbols[c] = (unsigned char)a->symbol_count++;
+            a->symbols[toupper(c)] = a->symbols[c];
+        }
+        if (a->word[c] && !in_word) length++;
+        in_word = a->word[c];
+        length++;
+    }
+    return length;
+}
+
+static void insert_pattern(Automaton* a, const char* pattern, unsigned int bit) {
+    int state = 0;
+    bool in_word = false;
+
+    for (const unsigned char* p = (const unsigned char*)pattern; *p; p++) {
+        int symbols[2];
+        int n = 0;
+
+        if (a->word[*p] && !in_word) symbols[n++] = SYMBOL_BOUNDARY;
+        symbols[n++] = a->symbols[*p];
+        in_word = a->word[*p];
+
+        for (int i = 0; i < n; i++) {
+            int* next = &a->delta[state * a->symbol_count + symbols[i]];
+            if (*next < 0) *next = a->state_count++;
+            state = *next;
+        }
+    }
+    a->output[state] |= bit;
+}
+
+// Fill in the missing transitions breadth-first from the failure links
+static bool link_automaton(Automaton* a) {
+    int* fail = calloc(a->state_count, sizeof(int));
+    int* queue = malloc(a->state_count * sizeof(int));
+    if (!fail || !queue) {
+        free(fail);
+        free(queue);
+        return false;
+    }
+
+    int head = 0, tail = 0;
+    for (int s = 0; s < a->symbol_count; s++) {
+        int* next = &a->delta[s];
+        if (*next < 0) {
+            *next = 0;
+        } else {
+            fail[*next] = 0;
+            queue[tail++] = *next;
+        }
+    }
+
+    while (head < tail) {
+        int state = queue[head++];
+        int* row = &a->delta[state * a->symbol_count];
+        const int* fail_row = &a->delta[fail[state] * a->symbol_count];
+
+        // The failure state is shallower, so its output is already complete
+        a->output[state] |= a->output[fail[state]];
+        for (int s = 0; s < a->symbol_count; s++) {
+            if (row[s] < 0) {
+                row[s] = fail_row[s];
+            } else {
+                fail[row[s]] = fail_row[s];
+                queue[tail++] = row[s];
+            }
+        }
+    }
+
+    free(fail);
+    free(queue);
+    return true;
+}
+
+static bool build_automaton(Automaton* a, const char** specs, int count) {
+    memset(a, 0, sizeof(Automaton));
+    for (int c = 0; c < 256; c++) a->word[c] = isalnum(c) && c < 128;
+    a->symbol_count = SYMBOL_BOUNDARY + 1;
+
+    // First pass: the alphabet and an upper bound on the number of states
+    int max_states = 1;
+    for (int i = 0; i < count; i++) {
+        const char* pattern;
+        if (!parse_pattern(specs[i], &pattern)) {
+            fprintf(stderr, "Warning: Ignoring asset pattern (expected platform:text): %s\n", specs[i]);
+            continue;
+        }
+        int length = assign_symbols(a, pattern);
+        if (length < 0) return false;
+        max_states += length;
+    }
+
+    a->delta = malloc((size_t)max_states * a->symbol_count * sizeof(int));
+    a->output = calloc(max_states, sizeof(unsigned int));
+    if (!a->delta || !a->output) return false;
+    for (size_t i = 0; i < (size_t)max_states * a->symbol_count; i++) a->delta[i] = -1;
+
+    // Second pass: the trie
+    a->state_count = 1;
+    for (int i = 0; i < count; i++) {
+        const char* pattern;
+        unsigned int bit = parse_pattern(specs[i], &pattern);
+        if (bit) insert_pattern(a, pattern, bit);
+    }
+
+    return link_automaton(a);
+}
+
+// Compile the built-in patterns plus any from config.txt. Must run before
+// fetching starts; the automaton is read-only afterwards, so scans need no lock.
+bool asset_classifier_init(const char (*patterns)[MAX_ASSET_PATTERN_LENGTH], int count) {
+    int default_count = sizeof(g_default_patterns) / sizeof(g_default_patterns[0]);
+    const char** specs = malloc((default_count + count) * sizeof(char*));
+    if (!specs) return false;
+
+    for (int i = 0; i < default_count; i++) specs[i] = g_default_patterns[i];
+    for (int i = 0; i < count; i++) specs[default_count + i] = patterns[i];
+
+    asset_classifier_cleanup();
+    bool ok = build_automaton(&g_automaton, specs, default_count + count);
+    free(specs);
+
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to build asset classifier\n");
+        asset_classifier_cleanup();
+    }
+    return ok;
+}
+
+void asset_classifier_cleanup(void) {
+    free(g_automaton.delta);
+    free(g_automaton.output);
+    memset(&g_automaton, 0, sizeof(Automaton));
+}
+
+void begin_asset_scan(AssetScan* scan) {
+    scan->state = 0;
+    scan->in_word = false;
+    scan->mask = 0;
+}
+
+void feed_asset_scan(AssetScan* scan, const char* data, size_t len) {
+    const Automaton* a = &g_automaton;
+    if (!a->delta) return;
+
+    int state = scan->state;
+    bool in_word = scan->in_word;
+    unsigned int mask = scan->mask;
+
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = (unsigned char)data[i];
+        if (a->word[c] && !in_word) {
+            state = a->delta[state * a->symbol_count + SYMBOL_BOUNDARY];
+            mask |= a->output[state];
+        }
+        state = a->delta[state * a->symbol_count + a->symbols[c]];
+        mask |= a->output[state];
+        in_word = a->word[c];
+    }
+
+    scan->state = state;
+    scan->in_word = in_word;
+    scan->mask = mask;
+}
+
+unsigned int classify_asset_name(const char* name, size_t len) {
+    AssetScan scan;
+    begin_asset_scan(&scan);
+    feed_asset_scan(&scan, name, len);
+    return scan.mask;
+}
+
+// Column heading for bit (1 << index)
+const char* asset_class_label(int index) {
+    return (index >= 0 && index < ASSET_CLASS_COUNT) ? g_classes[index].label : "";
+}
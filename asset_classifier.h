@@ -0,0 +1,31 @@
+#ifndef ASSET_CLASSIFIER_H
+#define ASSET_CLASSIFIER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "config.h"
+
+// Platform and architecture bits of Release.platforms
+#define ASSET_WINDOWS 0x01
+#define ASSET_LINUX   0x02
+#define ASSET_MACOS   0x04
+#define ASSET_X64     0x08
+#define ASSET_ARM64   0x10
+#define ASSET_CLASS_COUNT 5
+
+// State of one asset name being scanned; names can arrive in pieces
+typedef struct {
+    int state;
+    bool in_word;           // Previous character was a letter or digit
+    unsigned int mask;      // ASSET_* bits matched so far
+} AssetScan;
+
+// Function declarations
+bool asset_classifier_init(const char (*patterns)[MAX_ASSET_PATTERN_LENGTH], int count);
+void asset_classifier_cleanup(void);
+void begin_asset_scan(AssetScan* scan);
+void feed_asset_scan(AssetScan* scan, const char* data, size_t len);
+unsigned int classify_asset_name(const char* name, size_t len);
+const char* asset_class_label(int index);
+
+#endif // ASSET_CLASSIFIER_H
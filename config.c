@@ -1,11 +1,13 @@
 #include "config.h"
+#include "string_table.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <Windows.h>
+#include "platform.h"
 
-char* get_config_path(void) {
-    static char path[MAX_PATH_LENGTH];
+// Build the path of a file that lives next to the executable
+static char* get_app_file_path(char* path, const char* file_name) {
+#ifdef _WIN32
     HMODULE hModule = GetModuleHandle(NULL);
     if (hModule == NULL) {
         fprintf(stderr, "Error: Could not get module handle.\n");
@@ -18,24 +20,42 @@ char* get_config_path(void) {
         fprintf(stderr, "Error: Could not get module file name.\n");
         return NULL;
     }
+#else
+    ssize_t length = readlink("/proc/self/exe", path, MAX_PATH_LENGTH - 1);
+    if (length <= 0) {
+        fprintf(stderr, "Error: Could not get executable path.\n");
+        return NULL;
+    }
+    path[length] = '\0';
+#endif
 
-    // Find the last backslash (directory separator)
-    char* last_backslash = strrchr(path, '\\');
-    if (last_backslash != NULL) {
-        // Null-terminate the string after the last backslash to get the directory path
-        *(last_backslash + 1) = '\0';
+    // Find the last directory separator
+    char* last_separator = strrchr(path, PATH_SEPARATOR);
+    if (last_separator != NULL) {
+        // Null-terminate the string after the last separator to get the directory path
+        *(last_separator + 1) = '\0';
     } else {
-        // If no backslash, it's just the executable name, so use current directory
+        // If no separator, it's just the executable name, so use current directory
         path[0] = '.';
-        path[1] = '\\';
+        path[1] = PATH_SEPARATOR;
         path[2] = '\0';
     }
 
-    // Append the config file name
-    strncat(path, "config.txt", MAX_PATH_LENGTH - strlen(path) - 1);
+    // Append the file name
+    strncat(path, file_name, MAX_PATH_LENGTH - strlen(path) - 1);
     return path;
 }
 
+char* get_config_path(void) {
+    static char path[MAX_PATH_LENGTH];
+    return get_app_file_path(path, "config.txt");
+}
+
+char* get_cache_path(void) {
+    static char path[MAX_PATH_LENGTH];
+    return get_app_file_path(path, "release_cache.txt");
+}
+
 Config* load_config(const char* path) {
     FILE* fp;
     char line[1024];
@@ -68,9 +88,9 @@ Config* load_config(const char* path) {
     // Load API key from api.txt in the same directory as config.txt
     strncpy(api_path, path, MAX_PATH_LENGTH - 1);
     api_path[MAX_PATH_LENGTH - 1] = '\0';
-    char* last_backslash = strrchr(api_path, '\\');
-    if (last_backslash) {
-        *(last_backslash + 1) = '\0';
+    char* last_separator = strrchr(api_path, PATH_SEPARATOR);
+    if (last_separator) {
+        *(last_separator + 1) = '\0';
         strncat(api_path, "api.txt", MAX_PATH_LENGTH - strlen(api_path) - 1);
     } else {
         strncpy(api_path, "api.txt", MAX_PATH_LENGTH - 1);
@@ -104,6 +124,19 @@ Config* load_config(const char* path) {
         // Remove PAT parsing from config.txt
         if (strncmp(line, "pat=", 4) == 0) {
             continue;
+        } else if (strncmp(line, "connections=", 12) == 0) {
+            config->connection_count = atoi(line + 12);
+            if (config->connection_count < 0) config->connection_count = 0;
+        } else if (strncmp(line, "fetch_mode=", 11) == 0) {
+            config->use_graphql = (strcmp(line + 11, "graphql") == 0);
+        } else if (strncmp(line, "asset_pattern=", 14) == 0) {
+            if (config->asset_pattern_count < MAX_ASSET_PATTERNS) {
+                char* pattern = config->asset_patterns[config->asset_pattern_count++];
+                strncpy(pattern, line + 14, MAX_ASSET_PATTERN_LENGTH - 1);
+                pattern[MAX_ASSET_PATTERN_LENGTH - 1] = '\0';
+            } else {
+                fprintf(stderr, "Warning: Too many asset patterns, ignoring: %s\n", line + 14);
+            }
         } else {
             // Assume it's a repository line (owner/repo)
             char* slash = strchr(line, '/');
@@ -121,16 +154,28 @@ Config* load_config(const char* path) {
                 }
                 
                 *slash = '\0';
-                strncpy(config->repos[config->repo_count].owner, line, MAX_REPO_NAME_LENGTH - 1);
-                strncpy(config->repos[config->repo_count].repo, slash + 1, MAX_REPO_NAME_LENGTH - 1);
-                config->repos[config->repo_count].owner[MAX_REPO_NAME_LENGTH - 1] = '\0';
-                config->repos[config->repo_count].repo[MAX_REPO_NAME_LENGTH - 1] = '\0';
+                // Request paths, cache keys and search text are all sized on this limit
+                if (strlen(line) >= MAX_REPO_NAME_LENGTH || strlen(slash + 1) >= MAX_REPO_NAME_LENGTH) {
+                    fprintf(stderr, "Warning: Owner or repository name too long, ignoring: %s/%s\n", line, slash + 1);
+                    continue;
+                }
+                
+                RepoInfo* repo = &config->repos[config->repo_count];
+                repo->owner_id = intern_string(line);
+                repo->repo_id = intern_string(slash + 1);
+                if (repo->owner_id < 0 || repo->repo_id < 0) {
+                    fprintf(stderr, "Error: Failed to allocate memory for repos\n");
+                    fclose(fp);
+                    free_config(config);
+                    return NULL;
+                }
+                repo->owner = get_interned_string(repo->owner_id);
+                repo->repo = get_interned_string(repo->repo_id);
                 
-                printf("Loading Config: Owner: %s, Repo: %s\n", 
-                       config->repos[config->repo_count].owner, config->repos[config->repo_count].repo);
+                printf("Loading Config: Owner: %s, Repo: %s\n", repo->owner, repo->repo);
                 config->repo_count++;
             } else {
-                fprintf(stderr, "Warning: Invalid line in config (expected owner/repo or pat=): %s\n", line);
+                fprintf(stderr, "Warning: Invalid line in config (expected owner/repo or connections=): %s\n", line);
             }
         }
     }
@@ -4,12 +4,24 @@
 #include <stdbool.h>
 
 #define MAX_PATH_LENGTH 512
+
+#ifdef _WIN32
+#define PATH_SEPARATOR '\\'
+#else
+#define PATH_SEPARATOR '/'
+#endif
 #define MAX_TOKEN_LENGTH 256
 #define MAX_REPO_NAME_LENGTH 128
+#define MAX_ASSET_PATTERNS 32
+#define MAX_ASSET_PATTERN_LENGTH 64
 
+// Names are interned (see string_table.h), so repositories of the same
+// owner share one copy and the ids go straight into every Release
 typedef struct {
-    char owner[MAX_REPO_NAME_LENGTH];
-    char repo[MAX_REPO_NAME_LENGTH];
+    int owner_id;
+    int repo_id;
+    const char* owner;
+    const char* repo;
 } RepoInfo;
 
 typedef struct {
@@ -17,12 +29,17 @@ typedef struct {
     RepoInfo* repos;
     int repo_count;
     int repo_capacity;
+    int connection_count;  // Concurrent requests; 0 = HTTP_POOL_DEFAULT_CONNECTIONS
+    bool use_graphql;      // Batch latest-release lookups through GraphQL
+    char asset_patterns[MAX_ASSET_PATTERNS][MAX_ASSET_PATTERN_LENGTH];  // "platform:text"
+    int asset_pattern_count;
 } Config;
 
 // Function declarations
 Config* load_config(const char* path);
 void free_config(Config* config);
 char* get_config_path(void);
+char* get_cache_path(void);
 bool validate_config(const Config* config);
 
 #endif // CONFIG_H
@@ -0,0 +1,34 @@
+#ifndef FETCH_ENGINE_H
+#define FETCH_ENGINE_H
+
+#include <stdbool.h>
+#include "platform.h"
+#include "config.h"
+#include "requests.h"
+
+#define FETCH_RESPONSE_INITIAL_CAPACITY 16384
+#define FETCH_REQUEST_TIMEOUT_MS 30000
+
+// Per-repository request state; every fetch walks these in order
+typedef enum {
+    FETCH_STATE_QUEUED,
+    FETCH_STATE_CONNECTING,
+    FETCH_STATE_HANDSHAKE,
+    FETCH_STATE_SENDING,
+    FETCH_STATE_RECEIVING,
+    FETCH_STATE_READING,
+    FETCH_STATE_CLOSING
+} FetchState;
+
+// Event-driven fetcher: a single driver thread multiplexes every in-flight
+// request (WinHTTP async callbacks on Windows, epoll elsewhere) and feeds the
+// results into a ReleaseQueue for the UI thread.
+typedef struct FetchEngine FetchEngine;
+
+// Function declarations
+FetchEngine* create_fetch_engine(int max_in_flight, ReleaseQueue* results, const char* auth_token);
+void free_fetch_engine(FetchEngine* engine);
+bool submit_fetch(FetchEngine* engine, const RepoInfo* repo);
+bool submit_graphql_batch(FetchEngine* engine, const RepoInfo* repos, int count);
+
+#endif // FETCH_ENGINE_H
@@ -0,0 +1,870 @@
+#ifndef _WIN32
+#include "fetch_engine.h"
+#include "http_pool.h"
+#include "release_cache.h"
+#include "release_parser.h"
+#include "scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+
+#define MAX_HEADER_BYTES 16384
+#define MAX_CHUNK_LINE 64
+#define READ_BUFFER_SIZE 16384
+#define EPOLL_BATCH 64
+#define EPOLL_TICK_MS 1000
+
+// Chunked transfer-encoding decoder states
+typedef enum {
+    CHUNK_SIZE,
+    CHUNK_DATA,
+    CHUNK_DATA_END,
+    CHUNK_TRAILER,
+    CHUNK_DONE
+} ChunkState;
+
+typedef struct FetchRequest {
+    FetchEngine* engine;
+    RepoInfo repo;              // Single repo, or the first repo of a batch
+    RepoInfo* batch;            // GraphQL batch; NULL for a REST request
+    int batch_count;
+    char* post_body;
+    FetchState state;
+    HttpConnection* conn;
+    bool reused_connection;     // Sent over a socket kept alive from an earlier request
+    bool retried;
+    int status_code;
+    CacheValidators validators;     // Returned with a 200, stored in the cache
+    RateLimitHeaders rate_limit;
+    int attempts;               // Times the request was throttled and re-queued
+    bool answered;              // The scheduler has seen the response
+
+    char* request_text;
+    size_t request_len;
+    size_t request_sent;
+
+    char headers[MAX_HEADER_BYTES];
+    size_t header_len;
+    long content_length;        // -1 when the body runs until the socket closes
+    bool chunked;
+    bool keep_alive;
+
+    ChunkState chunk_state;
+    size_t chunk_remaining;
+    char chunk_line[MAX_CHUNK_LINE];
+    size_t chunk_line_len;
+
+    size_t body_received;
+    bool streaming;             // A 200 release body goes straight into the parser
+    ReleaseParser parser;
+    char* response;             // Buffered body of GraphQL and error responses
+    size_t response_len;
+    size_t response_capacity;
+
+    long long deadline_ms;
+    int active_index;
+    struct FetchRequest* next;
+} FetchRequest;
+
+struct FetchEngine {
+    int epoll_fd;
+    int wake_fd;
+    pthread_t thread;
+    CRITICAL_SECTION mutex;         // Guards the pending queue
+    FetchRequest* pending_head;
+    FetchRequest* pending_tail;
+    FetchRequest** active;          // In-flight requests, max_in_flight slots
+    int max_in_flight;
+    int in_flight;
+    int wait_ms;                    // Scheduler pause before the next dispatch; -1 for none
+    volatile LONG stopping;
+    ReleaseQueue* results;
+    const char* auth_token;
+    struct sockaddr_storage address;
+    socklen_t address_len;
+    bool address_resolved;
+};
+
+static long long now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static bool resolve_api_host(FetchEngine* engine) {
+    struct addrinfo hints = {0};
+    struct addrinfo* result = NULL;
+    char port[16];
+
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    snprintf(port, sizeof(port), "%d", GITHUB_API_PORT);
+
+    if (getaddrinfo(GITHUB_API_HOST, port, &hints, &result) != 0 || !result) {
+        fprintf(stderr, "Error: Failed to resolve %s\n", GITHUB_API_HOST);
+        return false;
+    }
+
+    memcpy(&engine->address, result->ai_addr, result->ai_addrlen);
+    engine->address_len = result->ai_addrlen;
+    freeaddrinfo(result);
+    return true;
+}
+
+static void watch_request(FetchRequest* request, uint32_t events) {
+    struct epoll_event ev = {0};
+    ev.events = events;
+    ev.data.ptr = request;
+    if (epoll_ctl(request->engine->epoll_fd, EPOLL_CTL_MOD, request->conn->fd, &ev) < 0) {
+        epoll_ctl(request->engine->epoll_fd, EPOLL_CTL_ADD, request->conn->fd, &ev);
+    }
+}
+
+static void unwatch_request(FetchRequest* request) {
+    if (request->conn && request->conn->fd >= 0) {
+        epoll_ctl(request->engine->epoll_fd, EPOLL_CTL_DEL, request->conn->fd, NULL);
+    }
+}
+
+static void free_request(FetchRequest* request) {
+    free_release_parser(&request->parser);
+    free(request->response);
+    free(request->request_text);
+    free(request->post_body);
+    free(request->batch);
+    free(request);
+}
+
+static void detach_request(FetchRequest* request, bool keep_connection) {
+    FetchEngine* engine = request->engine;
+
+    unwatch_request(request);
+    if (!keep_connection) {
+        http_pool_disconnect(request->conn);
+    }
+
+    engine->active[request->active_index] = NULL;
+    engine->in_flight--;
+
+    http_pool_release(request->conn);
+}
+
+static void finish_request(FetchRequest* request, bool keep_connection) {
+    detach_request(request, keep_connection);
+    scheduler_on_finished(!request->answered);
+    free_request(request);
+}
+
+// Put a throttled request back at the head of the queue; the scheduler holds
+// dispatch until the rate limit clears
+static void requeue_request(FetchRequest* request) {
+    FetchEngine* engine = request->engine;
+
+    detach_request(request, request->keep_alive);
+    free_release_parser(&request->parser);
+    free(request->response);
+    free(request->request_text);
+
+    FetchRequest fresh = {0};
+    fresh.engine = engine;
+    fresh.repo = request->repo;
+    fresh.batch = request->batch;
+    fresh.batch_count = request->batch_count;
+    fresh.post_body = request->post_body;
+    fresh.attempts = request->attempts + 1;
+    fresh.state = FETCH_STATE_QUEUED;
+    init_rate_limit_headers(&fresh.rate_limit);
+    *request = fresh;
+
+    EnterCriticalSection(&engine->mutex);
+    request->next = engine->pending_head;
+    engine->pending_head = request;
+    if (!engine->pending_tail) engine->pending_tail = request;
+    LeaveCriticalSection(&engine->mutex);
+}
+
+static void fail_request(FetchRequest* request, const char* what) {
+    fprintf(stderr, "Error: %s for %s/%s\n", what, request->repo.owner, request->repo.repo);
+    finish_request(request, false);
+}
+
+static void complete_request(FetchRequest* request) {
+    if (request->response) {
+        request->response[request->response_len] = '\0';
+    }
+
+    request->answered = true;
+    if (scheduler_on_response(request->status_code, &request->rate_limit, request->response)) {
+        if (request->attempts < SCHEDULER_MAX_RETRIES) {
+            requeue_request(request);
+            return;
+        }
+        fprintf(stderr, "Error: Still rate limited after %d retries for %s/%s\n",
+                request->attempts, request->repo.owner, request->repo.repo);
+    }
+
+    if (request->batch) {
+        process_graphql_batch_response(request->batch, request->batch_count, request->status_code,
+                                       request->response, request->engine->results);
+    } else if (request->streaming && request->body_received > 0) {
+        Release release;
+        finish_release_parser(&request->parser, &release);
+        process_release_response(&request->repo, request->status_code, &release,
+                                 &request->validators, request->engine->results);
+    } else {
+        process_release_response(&request->repo, request->status_code, NULL,
+                                 &request->validators, request->engine->results);
+    }
+    finish_request(request, request->keep_alive);
+}
+
+static bool buffer_body(FetchRequest* request, const char* data, size_t len) {
+    if (request->response_len + len + 1 > request->response_capacity) {
+        size_t new_capacity = request->response_capacity ? request->response_capacity
+                                                         : FETCH_RESPONSE_INITIAL_CAPACITY;
+        while (new_capacity < request->response_len + len + 1) new_capacity *= 2;
+
+        char* new_response = realloc(request->response, new_capacity);
+        if (!new_response) return false;
+        request->response = new_response;
+        request->response_capacity = new_capacity;
+    }
+
+    memcpy(request->response + request->response_len, data, len);
+    request->response_len += len;
+    return true;
+}
+
+// Parse release bodies as they arrive; once the parser has every field it
+// needs, the rest of the body is read off the socket and dropped
+static bool append_body(FetchRequest* request, const char* data, size_t len) {
+    request->body_received += len;
+    if (request->streaming) {
+        return feed_release_parser(&request->parser, data, len);
+    }
+    return buffer_body(request, data, len);
+}
+
+// Feed de-chunked body bytes; returns false on malformed input
+static bool feed_chunked(FetchRequest* request, const char* data, size_t len) {
+    size_t pos = 0;
+
+    while (pos < len && request->chunk_state != CHUNK_DONE) {
+        switch (request->chunk_state) {
+            case CHUNK_SIZE:
+            case CHUNK_TRAILER:
+            case CHUNK_DATA_END: {
+                char c = data[pos++];
+                if (c != '\n') {
+                    if (request->chunk_line_len >= MAX_CHUNK_LINE - 1) return false;
+                    request->chunk_line[request->chunk_line_len++] = c;
+                    break;
+                }
+
+                // Complete line (the trailing \r is still in the buffer)
+                if (request->chunk_line_len > 0 &&
+                    request->chunk_line[request->chunk_line_len - 1] == '\r') {
+                    request->chunk_line_len--;
+                }
+                request->chunk_line[request->chunk_line_len] = '\0';
+                size_t line_len = request->chunk_line_len;
+                request->chunk_line_len = 0;
+
+                if (request->chunk_state == CHUNK_DATA_END) {
+                    if (line_len != 0) return false;
+                    request->chunk_state = CHUNK_SIZE;
+                } else if (request->chunk_state == CHUNK_TRAILER) {
+                    if (line_len == 0) request->chunk_state = CHUNK_DONE;
+                } else {
+                    char* end = NULL;
+                    request->chunk_remaining = strtoul(request->chunk_line, &end, 16);
+                    if (end == request->chunk_line) return false;
+                    request->chunk_state = request->chunk_remaining ? CHUNK_DATA : CHUNK_TRAILER;
+                }
+                break;
+            }
+
+            case CHUNK_DATA: {
+                size_t take = len - pos;
+                if (take > request->chunk_remaining) take = request->chunk_remaining;
+                if (!append_body(request, data + pos, take)) return false;
+                pos += take;
+                request->chunk_remaining -= take;
+                if (request->chunk_remaining == 0) request->chunk_state = CHUNK_DATA_END;
+                break;
+            }
+
+            case CHUNK_DONE:
+                break;
+        }
+    }
+
+    return true;
+}
+
+static bool body_complete(FetchRequest* request) {
+    if (request->chunked) return request->chunk_state == CHUNK_DONE;
+    if (request->content_length >= 0) return (long)request->body_received >= request->content_length;
+    return false;
+}
+
+static void copy_header_value(char* dest, size_t size, const char* value, const char* end) {
+    size_t len = end - value;
+    if (len >= size) len = size - 1;
+    memcpy(dest, value, len);
+    dest[len] = '\0';
+}
+
+// Parse the status line and the headers we care about
+static bool parse_headers(FetchRequest* request) {
+    int major = 1, minor = 1;
+    if (sscanf(request->headers, "HTTP/%d.%d %d", &major, &minor, &request->status_code) != 3) {
+        return false;
+    }
+
+    request->content_length = -1;
+    request->keep_alive = (major > 1 || minor >= 1);
+
+    char* line = strstr(request->headers, "\r\n");
+    while (line && line[2] != '\r') {
+        line += 2;
+        char* value = strchr(line, ':');
+        char* next = strstr(line, "\r\n");
+        if (!value || !next || value > next) break;
+        value++;
+        while (*value == ' ' || *value == '\t') value++;
+
+        if (strncasecmp(line, "Content-Length:", 15) == 0) {
+            request->content_length = strtol(value, NULL, 10);
+        } else if (strncasecmp(line, "Transfer-Encoding:", 18) == 0) {
+            request->chunked = (strncasecmp(value, "chunked", 7) == 0);
+        } else if (strncasecmp(line, "Connection:", 11) == 0) {
+            if (strncasecmp(value, "close", 5) == 0) request->keep_alive = false;
+        } else if (strncasecmp(line, "ETag:", 5) == 0) {
+            copy_header_value(request->validators.etag, MAX_VALIDATOR_LENGTH, value, next);
+        } else if (strncasecmp(line, "Last-Modified:", 14) == 0) {
+            copy_header_value(request->validators.last_modified, MAX_VALIDATOR_LENGTH, value, next);
+        } else if (strncasecmp(line, "X-RateLimit-Limit:", 18) == 0) {
+            request->rate_limit.limit = strtol(value, NULL, 10);
+        } else if (strncasecmp(line, "X-RateLimit-Remaining:", 22) == 0) {
+            request->rate_limit.remaining = strtol(value, NULL, 10);
+        } else if (strncasecmp(line, "X-RateLimit-Reset:", 18) == 0) {
+            request->rate_limit.reset = strtoll(value, NULL, 10);
+        } else if (strncasecmp(line, "Retry-After:", 12) == 0) {
+            request->rate_limit.retry_after = strtol(value, NULL, 10);
+        }
+        line = next;
+    }
+
+    // 304 and 204 never carry a body
+    if (request->status_code == 304 || request->status_code == 204) {
+        request->content_length = 0;
+        request->chunked = false;
+    }
+
+    // Without a length or chunking the body is delimited by the socket closing
+    if (!request->chunked && request->content_length < 0) request->keep_alive = false;
+    return true;
+}
+
+static bool feed_response(FetchRequest* request, const char* data, size_t len) {
+    if (request->state == FETCH_STATE_RECEIVING) {
+        // Accumulate until the blank line that ends the headers
+        size_t take = len;
+        if (request->header_len + take > MAX_HEADER_BYTES - 1) {
+            take = MAX_HEADER_BYTES - 1 - request->header_len;
+        }
+        memcpy(request->headers + request->header_len, data, take);
+        request->header_len += take;
+        request->headers[request->header_len] = '\0';
+
+        char* end = strstr(request->headers, "\r\n\r\n");
+        if (!end) return request->header_len < MAX_HEADER_BYTES - 1;
+
+        size_t header_bytes = (end + 4) - request->headers;
+        size_t body_offset = header_bytes - (request->header_len - take);
+        end[2] = '\0';
+        if (!parse_headers(request)) return false;
+
+        request->streaming = (request->status_code == 200 && !request->batch);
+        if (request->streaming) init_release_parser(&request->parser, &request->repo);
+
+        request->state = FETCH_STATE_READING;
+        data += body_offset;
+        len -= body_offset;
+    }
+
+    if (len == 0) return true;
+    if (request->chunked) return feed_chunked(request, data, len);
+    return append_body(request, data, len);
+}
+
+static void drive_request(FetchRequest* request);
+
+static void retry_or_fail(FetchRequest* request, const char* what) {
+    // A keep-alive socket may have been closed by the server while idle
+    if (request->reused_connection && !request->retried && request->header_len == 0) {
+        unwatch_request(request);
+        http_pool_disconnect(request->conn);
+        request->retried = true;
+        request->reused_connection = false;
+        request->request_sent = 0;
+        request->state = FETCH_STATE_CONNECTING;
+        drive_request(request);
+        return;
+    }
+    fail_request(request, what);
+}
+
+static void open_socket(FetchRequest* request) {
+    FetchEngine* engine = request->engine;
+    HttpConnection* conn = request->conn;
+
+    if (!engine->address_resolved) {
+        engine->address_resolved = resolve_api_host(engine);
+        if (!engine->address_resolved) {
+            fail_request(request, "Failed to connect to GitHub API");
+            return;
+        }
+    }
+
+    conn->fd = socket(engine->address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (conn->fd < 0) {
+        fail_request(request, "Failed to create socket");
+        return;
+    }
+
+    int one = 1;
+    setsockopt(conn->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    if (connect(conn->fd, (struct sockaddr*)&engine->address, engine->address_len) < 0 &&
+        errno != EINPROGRESS) {
+        fail_request(request, "Failed to connect to GitHub API");
+        return;
+    }
+
+    request->state = FETCH_STATE_CONNECTING;
+    watch_request(request, EPOLLOUT);
+}
+
+static bool start_tls(FetchRequest* request) {
+    HttpConnection* conn = request->conn;
+
+    conn->ssl = SSL_new(http_pool_tls_context());
+    if (!conn->ssl) return false;
+
+    SSL_set_fd(conn->ssl, conn->fd);
+    SSL_set_tlsext_host_name(conn->ssl, GITHUB_API_HOST);
+    SSL_set1_host(conn->ssl, GITHUB_API_HOST);
+    SSL_set_connect_state(conn->ssl);
+
+    request->state = FETCH_STATE_HANDSHAKE;
+    return true;
+}
+
+// Advance the request as far as the socket allows without blocking
+static void drive_request(FetchRequest* request) {
+    HttpConnection* conn = request->conn;
+
+    for (;;) {
+        switch (request->state) {
+            case FETCH_STATE_QUEUED:
+            case FETCH_STATE_CONNECTING:
+                if (conn->fd < 0) {
+                    open_socket(request);
+                    return;
+                } else {
+                    int error = 0;
+                    socklen_t error_len = sizeof(error);
+                    getsockopt(conn->fd, SOL_SOCKET, SO_ERROR, &error, &error_len);
+                    if (error == EINPROGRESS) return;
+                    if (error != 0 || !start_tls(request)) {
+                        fail_request(request, "Failed to connect to GitHub API");
+                        return;
+                    }
+                }
+                break;
+
+            case FETCH_STATE_HANDSHAKE: {
+                int result = SSL_do_handshake(conn->ssl);
+                if (result == 1) {
+                    InterlockedIncrement(&conn->handshakes);
+                    request->state = FETCH_STATE_SENDING;
+                    break;
+                }
+                int error = SSL_get_error(conn->ssl, result);
+                if (error == SSL_ERROR_WANT_READ) {
+                    watch_request(request, EPOLLIN);
+                } else if (error == SSL_ERROR_WANT_WRITE) {
+                    watch_request(request, EPOLLOUT);
+                } else {
+                    fail_request(request, "TLS handshake failed");
+                }
+                return;
+            }
+
+            case FETCH_STATE_SENDING: {
+                int result = SSL_write(conn->ssl, request->request_text + request->request_sent,
+                                       (int)(request->request_len - request->request_sent));
+                if (result > 0) {
+                    request->request_sent += result;
+                    if (request->request_sent == request->request_len) {
+                        request->state = FETCH_STATE_RECEIVING;
+                        watch_request(request, EPOLLIN);
+                    }
+                    break;
+                }
+                int error = SSL_get_error(conn->ssl, result);
+                if (error == SSL_ERROR_WANT_WRITE) {
+                    watch_request(request, EPOLLOUT);
+                } else if (error == SSL_ERROR_WANT_READ) {
+                    watch_request(request, EPOLLIN);
+                } else {
+                    retry_or_fail(request, "Failed to send HTTP request");
+                }
+                return;
+            }
+
+            case FETCH_STATE_RECEIVING:
+            case FETCH_STATE_READING: {
+                char buffer[READ_BUFFER_SIZE];
+                int result = SSL_read(conn->ssl, buffer, sizeof(buffer));
+                if (result > 0) {
+                    if (!feed_response(request, buffer, (size_t)result)) {
+                        fail_request(request, "Malformed HTTP response");
+                        return;
+                    }
+                    if (request->state == FETCH_STATE_READING && body_complete(request)) {
+                        complete_request(request);
+                        return;
+                    }
+                    break;
+                }
+
+                int error = SSL_get_error(conn->ssl, result);
+                if (error == SSL_ERROR_WANT_READ) {
+                    // A renegotiation may have left the watch on EPOLLOUT,
+                    // which is always ready and would spin this thread
+                    watch_request(request, EPOLLIN);
+                    return;
+                } else if (error == SSL_ERROR_WANT_WRITE) {
+                    watch_request(request, EPOLLOUT);
+                    return;
+                }
+
+                // Peer closed: only a close-delimited body ends cleanly here
+                if (request->state == FETCH_STATE_READING && !request->chunked &&
+                    request->content_length < 0) {
+                    request->keep_alive = false;
+                    complete_request(request);
+                } else {
+                    retry_or_fail(request, "Connection closed before response completed");
+                }
+                return;
+            }
+
+            case FETCH_STATE_CLOSING:
+                return;
+        }
+    }
+}
+
+// Sized from its parts; false when the request could not be built whole
+static bool build_request_text(FetchEngine* engine, FetchRequest* request) {
+    size_t body_len = request->post_body ? strlen(request->post_body) : 0;
+    char conditional[2 * MAX_VALIDATOR_LENGTH + 64] = "";
+    int written;
+
+    if (!request->batch) {
+        // Revalidate against the cached copy so an unchanged release costs a 304
+        CacheValidators cached = {0};
+        if (release_cache_get_validators(&request->repo, &cached)) {
+            written = snprintf(conditional, sizeof(conditional), "%s%s%s%s%s%s",
+                               cached.etag[0] ? "If-None-Match: " : "", cached.etag,
+                               cached.etag[0] ? "\r\n" : "",
+                               cached.last_modified[0] ? "If-Modified-Since: " : "", cached.last_modified,
+                               cached.last_modified[0] ? "\r\n" : "");
+            // A cut header would be malformed; ask unconditionally instead
+            if (written < 0 || (size_t)written >= sizeof(conditional)) conditional[0] = '\0';
+        }
+    }
+
+    size_t capacity = 512 + strlen(engine->auth_token) + strlen(request->repo.owner) +
+                      strlen(request->repo.repo) + strlen(conditional) + body_len;
+    request->request_text = malloc(capacity);
+    if (!request->request_text) return false;
+
+    if (request->batch) {
+        written = snprintf(request->request_text, capacity,
+                 "POST /graphql HTTP/1.1\r\n"
+                 "Host: " GITHUB_API_HOST "\r\n"
+                 "Authorization: Bearer %s\r\n"
+                 "User-Agent: GReleaseMon-c/1.0\r\n"
+                 "Content-Type: application/json\r\n"
+                 "Content-Length: %zu\r\n"
+                 "Connection: keep-alive\r\n"
+                 "\r\n"
+                 "%s",
+                 engine->auth_token, body_len, request->post_body);
+    } else {
+        written = snprintf(request->request_text, capacity,
+                 "GET /repos/%s/%s/releases/latest HTTP/1.1\r\n"
+                 "Host: " GITHUB_API_HOST "\r\n"
+                 "Authorization: Bearer %s\r\n"
+                 "User-Agent: GReleaseMon-c/1.0\r\n"
+                 "Accept: application/vnd.github.v3+json\r\n"
+                 "%s"
+                 "Connection: keep-alive\r\n"
+                 "\r\n",
+                 request->repo.owner, request->repo.repo, engine->auth_token, conditional);
+    }
+
+    // Never send a cut request: request_len must match what is in the buffer
+    if (written < 0 || (size_t)written >= capacity) {
+        free(request->request_text);
+        request->request_text = NULL;
+        return false;
+    }
+    request->request_len = written;
+    return true;
+}
+
+static void start_request(FetchEngine* engine, FetchRequest* request, HttpConnection* conn) {
+    request->conn = conn;
+    request->reused_connection = (conn->fd >= 0 && conn->ssl != NULL);
+    request->deadline_ms = now_ms() + FETCH_REQUEST_TIMEOUT_MS;
+
+    for (int i = 0; i < engine->max_in_flight; i++) {
+        if (!engine->active[i]) {
+            engine->active[i] = request;
+            request->active_index = i;
+            break;
+        }
+    }
+    engine->in_flight++;
+
+    if (!build_request_text(engine, request)) {
+        fail_request(request, "Failed to build request");
+        return;
+    }
+    // Counted here, not on acquire, so attempts the scheduler turns away don't show
+    InterlockedIncrement(&conn->requests_served);
+
+    request->state = request->reused_connection ? FETCH_STATE_SENDING : FETCH_STATE_CONNECTING;
+    drive_request(request);
+}
+
+static void dispatch_pending(FetchEngine* engine) {
+    engine->wait_ms = -1;
+
+    while (engine->in_flight < engine->max_in_flight) {
+        HttpConnection* conn = NULL;
+        long long wait_ms = 0;
+
+        EnterCriticalSection(&engine->mutex);
+        FetchRequest* request = engine->pending_head;
+        if (request) {
+            conn = http_pool_acquire();
+            if (conn && !scheduler_acquire(&wait_ms)) {
+                // Out of quota: keep the request queued and come back later
+                http_pool_release(conn);
+                conn = NULL;
+                engine->wait_ms = wait_ms > 0 ? (int)wait_ms : EPOLL_TICK_MS;
+            } else if (conn) {
+                engine->pending_head = request->next;
+                if (!engine->pending_head) engine->pending_tail = NULL;
+                request->next = NULL;
+            }
+        }
+        LeaveCriticalSection(&engine->mutex);
+
+        if (!request || !conn) break;
+        start_request(engine, request, conn);
+    }
+}
+
+static void expire_requests(FetchEngine* engine) {
+    long long now = now_ms();
+    for (int i = 0; i < engine->max_in_flight; i++) {
+        if (engine->active[i] && engine->active[i]->deadline_ms <= now) {
+            fail_request(engine->active[i], "Request timed out");
+        }
+    }
+}
+
+static void cancel_all(FetchEngine* engine) {
+    EnterCriticalSection(&engine->mutex);
+    FetchRequest* request = engine->pending_head;
+    engine->pending_head = engine->pending_tail = NULL;
+    LeaveCriticalSection(&engine->mutex);
+
+    while (request) {
+        FetchRequest* next = request->next;
+        scheduler_on_finished(false);
+        free_request(request);
+        request = next;
+    }
+
+    for (int i = 0; i < engine->max_in_flight; i++) {
+        if (engine->active[i]) finish_request(engine->active[i], false);
+    }
+}
+
+static void* engine_thread(void* arg) {
+    FetchEngine* engine = (FetchEngine*)arg;
+    struct epoll_event events[EPOLL_BATCH];
+
+    while (!engine->stopping) {
+        int timeout = engine->in_flight > 0 ? EPOLL_TICK_MS : -1;
+        if (engine->wait_ms >= 0 && (timeout < 0 || engine->wait_ms < timeout)) {
+            timeout = engine->wait_ms;
+        }
+        int count = epoll_wait(engine->epoll_fd, events, EPOLL_BATCH, timeout);
+        if (count < 0 && errno != EINTR) break;
+
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.ptr == NULL) {
+                uint64_t value;
+                if (read(engine->wake_fd, &value, sizeof(value)) < 0) {
+                    // Nothing to drain
+                }
+                continue;
+            }
+            drive_request((FetchRequest*)events[i].data.ptr);
+        }
+
+        if (engine->stopping) break;
+        expire_requests(engine);
+        dispatch_pending(engine);
+    }
+
+    cancel_all(engine);
+    return NULL;
+}
+
+static void wake_engine(FetchEngine* engine) {
+    uint64_t one = 1;
+    if (write(engine->wake_fd, &one, sizeof(one)) < 0) {
+        // Counter saturated; the thread is already awake
+    }
+}
+
+FetchEngine* create_fetch_engine(int max_in_flight, ReleaseQueue* results, const char* auth_token) {
+    if (max_in_flight < 1) max_in_flight = 1;
+
+    FetchEngine* engine = calloc(1, sizeof(FetchEngine));
+    if (!engine) return NULL;
+
+    engine->active = calloc(max_in_flight, sizeof(FetchRequest*));
+    engine->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    engine->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (!engine->active || engine->epoll_fd < 0 || engine->wake_fd < 0) {
+        if (engine->epoll_fd >= 0) close(engine->epoll_fd);
+        if (engine->wake_fd >= 0) close(engine->wake_fd);
+        free(engine->active);
+        free(engine);
+        return NULL;
+    }
+
+    struct epoll_event ev = {0};
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    epoll_ctl(engine->epoll_fd, EPOLL_CTL_ADD, engine->wake_fd, &ev);
+
+    engine->max_in_flight = max_in_flight;
+    engine->wait_ms = -1;
+    engine->results = results;
+    engine->auth_token = auth_token;
+    InitializeCriticalSection(&engine->mutex);
+
+    if (pthread_create(&engine->thread, NULL, engine_thread, engine) != 0) {
+        DeleteCriticalSection(&engine->mutex);
+        close(engine->epoll_fd);
+        close(engine->wake_fd);
+        free(engine->active);
+        free(engine);
+        return NULL;
+    }
+
+    return engine;
+}
+
+// Drops queued requests, aborts in-flight ones and joins the driver thread
+void free_fetch_engine(FetchEngine* engine) {
+    if (!engine) return;
+
+    __atomic_store_n(&engine->stopping, 1, __ATOMIC_SEQ_CST);
+    wake_engine(engine);
+    pthread_join(engine->thread, NULL);
+
+    close(engine->epoll_fd);
+    close(engine->wake_fd);
+    DeleteCriticalSection(&engine->mutex);
+    free(engine->active);
+    free(engine);
+}
+
+static void enqueue_request(FetchEngine* engine, FetchRequest* request) {
+    scheduler_add_pending(1);
+
+    EnterCriticalSection(&engine->mutex);
+    if (engine->pending_tail) {
+        engine->pending_tail->next = request;
+    } else {
+        engine->pending_head = request;
+    }
+    engine->pending_tail = request;
+    LeaveCriticalSection(&engine->mutex);
+
+    wake_engine(engine);
+}
+
+bool submit_fetch(FetchEngine* engine, const RepoInfo* repo) {
+    FetchRequest* request = calloc(1, sizeof(FetchRequest));
+    if (!request) return false;
+
+    request->engine = engine;
+    request->repo = *repo;
+    request->state = FETCH_STATE_QUEUED;
+    init_rate_limit_headers(&request->rate_limit);
+
+    enqueue_request(engine, request);
+    return true;
+}
+
+// Queue one GraphQL request answering latestRelease for up to
+// GRAPHQL_BATCH_SIZE repositories
+bool submit_graphql_batch(FetchEngine* engine, const RepoInfo* repos, int count) {
+    FetchRequest* request = calloc(1, sizeof(FetchRequest));
+    if (!request) return false;
+
+    request->engine = engine;
+    request->repo = repos[0];
+    request->batch = malloc(count * sizeof(RepoInfo));
+    request->post_body = build_graphql_batch_query(repos, count);
+    if (!request->batch || !request->post_body) {
+        free_request(request);
+        return false;
+    }
+    memcpy(request->batch, repos, count * sizeof(RepoInfo));
+    request->batch_count = count;
+    request->state = FETCH_STATE_QUEUED;
+    init_rate_limit_headers(&request->rate_limit);
+
+    enqueue_request(engine, request);
+    return true;
+}
+
+#endif // !_WIN32
@@ -0,0 +1,611 @@
+#ifdef _WIN32
+#include "fetch_engine.h"
+#include "http_pool.h"
+#include "release_cache.h"
+#include "release_parser.h"
+#include "scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <process.h>
+#include <winhttp.h>
+
+// Completion key used to wake the driver thread for new work or shutdown.
+// Every other key is the FetchRequest the event belongs to.
+#define ENGINE_WAKE_KEY ((ULONG_PTR)0)
+
+#define ENGINE_CALLBACK_FLAGS (WINHTTP_CALLBACK_FLAG_ALL_COMPLETIONS | \
+                               WINHTTP_CALLBACK_FLAG_HANDLES | \
+                               WINHTTP_CALLBACK_FLAG_CONNECT_TO_SERVER)
+
+typedef struct FetchRequest {
+    FetchEngine* engine;
+    RepoInfo repo;          // Single repo, or the first repo of a batch
+    RepoInfo* batch;        // GraphQL batch; NULL for a REST request
+    int batch_count;
+    char* post_body;
+    DWORD post_body_len;
+    FetchState state;
+    HttpConnection* conn;
+    HINTERNET hRequest;
+    int status_code;
+    CacheValidators validators;     // Returned with a 200, stored in the cache
+    RateLimitHeaders rate_limit;
+    int attempts;                   // Times the request was throttled and re-queued
+    bool answered;                  // The scheduler has seen the response
+    bool retry;                     // Queue again once the handle is closed
+    bool streaming;                 // A 200 release body goes straight into the parser
+    bool discarding;                // Body read only so the connection can be reused
+    ReleaseParser parser;
+    DWORD body_received;
+    char* response;                 // Whole body, or the read buffer while streaming
+    DWORD response_len;
+    DWORD response_capacity;
+    int active_index;
+    struct FetchRequest* next;
+} FetchRequest;
+
+struct FetchEngine {
+    HANDLE iocp;
+    HANDLE thread;
+    CRITICAL_SECTION mutex;         // Guards the pending queue
+    FetchRequest* pending_head;
+    FetchRequest* pending_tail;
+    FetchRequest** active;          // In-flight requests, max_in_flight slots
+    int max_in_flight;
+    int in_flight;
+    DWORD wait_ms;                  // Scheduler pause before the next dispatch
+    volatile LONG stopping;
+    ReleaseQueue* results;
+    wchar_t headers[1024];
+};
+
+// WinHTTP invokes this on its own worker threads. It only forwards the event
+// to the driver thread, so all request state is touched by one thread.
+static void CALLBACK engine_status_callback(HINTERNET hInternet, DWORD_PTR dwContext,
+                                            DWORD dwInternetStatus, LPVOID lpvStatusInformation,
+                                            DWORD dwStatusInformationLength) {
+    FetchRequest* request = (FetchRequest*)dwContext;
+    DWORD value = 0;
+
+    if (!request) return;
+
+    switch (dwInternetStatus) {
+        case WINHTTP_CALLBACK_STATUS_CONNECTED_TO_SERVER:
+            InterlockedIncrement(&request->conn->handshakes);
+            return;
+        case WINHTTP_CALLBACK_STATUS_DATA_AVAILABLE:
+            value = *(DWORD*)lpvStatusInformation;
+            break;
+        case WINHTTP_CALLBACK_STATUS_READ_COMPLETE:
+            value = dwStatusInformationLength;
+            break;
+        case WINHTTP_CALLBACK_STATUS_REQUEST_ERROR:
+            value = ((WINHTTP_ASYNC_RESULT*)lpvStatusInformation)->dwError;
+            break;
+        case WINHTTP_CALLBACK_STATUS_SENDREQUEST_COMPLETE:
+        case WINHTTP_CALLBACK_STATUS_HEADERS_AVAILABLE:
+        case WINHTTP_CALLBACK_STATUS_HANDLE_CLOSING:
+            break;
+        default:
+            return;
+    }
+
+    // The status code travels in the OVERLAPPED pointer slot
+    PostQueuedCompletionStatus(request->engine->iocp, value, (ULONG_PTR)request,
+                               (LPOVERLAPPED)(ULONG_PTR)dwInternetStatus);
+}
+
+static void free_request(FetchRequest* request) {
+    free_release_parser(&request->parser);
+    free(request->response);
+    free(request->post_body);
+    free(request->batch);
+    free(request);
+}
+
+static void close_request(FetchRequest* request) {
+    if (request->state == FETCH_STATE_CLOSING) return;
+
+    // WinHTTP answers with HANDLE_CLOSING, where the request is freed
+    request->state = FETCH_STATE_CLOSING;
+    WinHttpCloseHandle(request->hRequest);
+}
+
+static void fail_request(FetchRequest* request, const char* what, DWORD error) {
+    if (request->state == FETCH_STATE_CLOSING) return;
+
+    fprintf(stderr, "Error: %s for %s/%s (%lu)\n", what,
+            request->repo.owner, request->repo.repo, error);
+    close_request(request);
+}
+
+static void complete_request(FetchRequest* request) {
+    if (request->response) {
+        request->response[request->response_len] = '\0';
+    }
+
+    request->answered = true;
+    if (scheduler_on_response(request->status_code, &request->rate_limit, request->response)) {
+        if (request->attempts < SCHEDULER_MAX_RETRIES) {
+            request->retry = true;
+            close_request(request);
+            return;
+        }
+        fprintf(stderr, "Error: Still rate limited after %d retries for %s/%s\n",
+                request->attempts, request->repo.owner, request->repo.repo);
+    }
+
+    if (request->batch) {
+        process_graphql_batch_response(request->batch, request->batch_count, request->status_code,
+                                       request->response, request->engine->results);
+    } else if (request->streaming && request->body_received > 0) {
+        Release release;
+        finish_release_parser(&request->parser, &release);
+        process_release_response(&request->repo, request->status_code, &release,
+                                 &request->validators, request->engine->results);
+    } else {
+        process_release_response(&request->repo, request->status_code, NULL,
+                                 &request->validators, request->engine->results);
+    }
+    close_request(request);
+}
+
+// Put a throttled request back at the head of the queue; the scheduler holds
+// dispatch until the rate limit clears
+static void requeue_request(FetchEngine* engine, FetchRequest* request) {
+    free_release_parser(&request->parser);
+    memset(&request->parser, 0, sizeof(request->parser));
+    request->streaming = false;
+    request->discarding = false;
+    request->body_received = 0;
+    free(request->response);
+    request->response = NULL;
+    request->response_len = request->response_capacity = 0;
+    request->status_code = 0;
+    memset(&request->validators, 0, sizeof(request->validators));
+    init_rate_limit_headers(&request->rate_limit);
+    request->hRequest = NULL;
+    request->conn = NULL;
+    request->answered = false;
+    request->retry = false;
+    request->attempts++;
+    request->state = FETCH_STATE_QUEUED;
+
+    EnterCriticalSection(&engine->mutex);
+    request->next = engine->pending_head;
+    engine->pending_head = request;
+    if (!engine->pending_tail) engine->pending_tail = request;
+    LeaveCriticalSection(&engine->mutex);
+}
+
+static void request_closed(FetchEngine* engine, FetchRequest* request) {
+    engine->active[request->active_index] = NULL;
+    engine->in_flight--;
+
+    http_pool_release(request->conn);
+    if (request->retry && !engine->stopping) {
+        requeue_request(engine, request);
+        return;
+    }
+
+    scheduler_on_finished(!request->answered);
+    free_request(request);
+}
+
+static long query_header_number(HINTERNET hRequest, DWORD query, const wchar_t* name) {
+    DWORD value = 0;
+    DWORD size = sizeof(value);
+
+    if (!WinHttpQueryHeaders(hRequest, query | WINHTTP_QUERY_FLAG_NUMBER,
+                             name, &value, &size, WINHTTP_NO_HEADER_INDEX)) {
+        return -1;
+    }
+    return (long)value;
+}
+
+static void query_rate_limit_headers(HINTERNET hRequest, RateLimitHeaders* headers) {
+    headers->limit = query_header_number(hRequest, WINHTTP_QUERY_CUSTOM, L"X-RateLimit-Limit");
+    headers->remaining = query_header_number(hRequest, WINHTTP_QUERY_CUSTOM, L"X-RateLimit-Remaining");
+    headers->reset = query_header_number(hRequest, WINHTTP_QUERY_CUSTOM, L"X-RateLimit-Reset");
+    headers->retry_after = query_header_number(hRequest, WINHTTP_QUERY_RETRY_AFTER,
+                                               WINHTTP_HEADER_NAME_BY_INDEX);
+}
+
+// Read a response header as UTF-8; leaves out empty when the header is absent
+static void query_header_utf8(HINTERNET hRequest, DWORD query, char* out, int out_size) {
+    wchar_t value[MAX_VALIDATOR_LENGTH];
+    DWORD size = sizeof(value);
+
+    out[0] = '\0';
+    if (WinHttpQueryHeaders(hRequest, query, WINHTTP_HEADER_NAME_BY_INDEX, value, &size,
+                            WINHTTP_NO_HEADER_INDEX)) {
+        WideCharToMultiByte(CP_UTF8, 0, value, -1, out, out_size, NULL, NULL);
+        out[out_size - 1] = '\0';
+    }
+}
+
+// Revalidate against the cached copy so an unchanged release costs a 304
+static void add_conditional_headers(FetchRequest* request) {
+    CacheValidators cached;
+    if (!release_cache_get_validators(&request->repo, &cached)) return;
+
+    wchar_t headers[2 * MAX_VALIDATOR_LENGTH + 64];
+    int len = 0;
+    int written = 0;
+    if (cached.etag[0]) {
+        written = swprintf(headers + len, sizeof(headers)/sizeof(wchar_t) - len,
+                           L"If-None-Match: %hs\r\n", cached.etag);
+        if (written > 0) len += written;
+    }
+    if (cached.last_modified[0] && written >= 0) {
+        written = swprintf(headers + len, sizeof(headers)/sizeof(wchar_t) - len,
+                           L"If-Modified-Since: %hs\r\n", cached.last_modified);
+        if (written > 0) len += written;
+    }
+    // swprintf returns -1 when cut short; a cut header is worse than none
+    if (written >= 0 && len > 0) {
+        WinHttpAddRequestHeaders(request->hRequest, headers, (DWORD)-1, WINHTTP_ADDREQ_FLAG_ADD);
+    }
+}
+
+static void start_request(FetchEngine* engine, FetchRequest* request, HttpConnection* conn) {
+    wchar_t wszPath[512];
+    int written;
+    if (request->batch) {
+        written = swprintf(wszPath, sizeof(wszPath)/sizeof(wchar_t), L"/graphql");
+    } else {
+        written = swprintf(wszPath, sizeof(wszPath)/sizeof(wchar_t),
+                           L"/repos/%hs/%hs/releases/latest", request->repo.owner, request->repo.repo);
+    }
+
+    request->conn = conn;
+    request->hRequest = written < 0 ? NULL : WinHttpOpenRequest(conn->hConnect, request->batch ? L"POST" : L"GET",
+                                           wszPath, NULL,
+                                           WINHTTP_NO_REFERER, WINHTTP_DEFAULT_ACCEPT_TYPES,
+                                           WINHTTP_FLAG_SECURE);
+    if (!request->hRequest) {
+        fprintf(stderr, "Error: Failed to create HTTP request for %s/%s\n",
+                request->repo.owner, request->repo.repo);
+        http_pool_release(conn);
+        scheduler_on_finished(true);
+        free_request(request);
+        return;
+    }
+
+    for (int i = 0; i < engine->max_in_flight; i++) {
+        if (!engine->active[i]) {
+            engine->active[i] = request;
+            request->active_index = i;
+            break;
+        }
+    }
+    engine->in_flight++;
+
+    // Context must be in place before the callback can fire (even HANDLE_CLOSING)
+    DWORD_PTR context = (DWORD_PTR)request;
+    WinHttpSetOption(request->hRequest, WINHTTP_OPTION_CONTEXT_VALUE, &context, sizeof(context));
+    WinHttpSetStatusCallback(request->hRequest, engine_status_callback, ENGINE_CALLBACK_FLAGS, 0);
+
+    if (request->post_body) {
+        WinHttpAddRequestHeaders(request->hRequest, L"Content-Type: application/json\r\n",
+                                 (DWORD)-1, WINHTTP_ADDREQ_FLAG_ADD);
+    } else {
+        add_conditional_headers(request);
+    }
+
+    request->state = FETCH_STATE_SENDING;
+    if (!WinHttpSendRequest(request->hRequest, engine->headers, -1,
+                            request->post_body ? request->post_body : WINHTTP_NO_REQUEST_DATA,
+                            request->post_body_len, request->post_body_len, context)) {
+        fail_request(request, "Failed to send HTTP request", GetLastError());
+    } else {
+        // Counted here, not on acquire, so attempts the scheduler turns away don't show
+        InterlockedIncrement(&conn->requests_served);
+    }
+}
+
+static void handle_event(FetchRequest* request, DWORD status, DWORD value) {
+    FetchEngine* engine = request->engine;
+
+    if (status == WINHTTP_CALLBACK_STATUS_HANDLE_CLOSING) {
+        request_closed(engine, request);
+        return;
+    }
+    if (request->state == FETCH_STATE_CLOSING) return;
+
+    switch (status) {
+        case WINHTTP_CALLBACK_STATUS_SENDREQUEST_COMPLETE:
+            request->state = FETCH_STATE_RECEIVING;
+            if (!WinHttpReceiveResponse(request->hRequest, NULL)) {
+                fail_request(request, "Failed to receive response", GetLastError());
+            }
+            break;
+
+        case WINHTTP_CALLBACK_STATUS_HEADERS_AVAILABLE: {
+            DWORD dwStatusCode = 0;
+            DWORD dwStatusCodeSize = sizeof(dwStatusCode);
+            WinHttpQueryHeaders(request->hRequest, WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
+                               WINHTTP_HEADER_NAME_BY_INDEX, &dwStatusCode, &dwStatusCodeSize,
+                               WINHTTP_NO_HEADER_INDEX);
+            request->status_code = (int)dwStatusCode;
+            query_rate_limit_headers(request->hRequest, &request->rate_limit);
+
+            // Only a successful response carries a body worth reading, plus a
+            // 403/429 whose message tells a rate limit from a permission error;
+            // a 304 is answered from the release cache. Other bodies are still
+            // read to the end, or WinHTTP cannot reuse the connection.
+            request->discarding = (request->status_code != 200 && request->status_code != 403 &&
+                                   request->status_code != 429);
+            request->state = FETCH_STATE_READING;
+            if (request->discarding) {
+                if (!WinHttpQueryDataAvailable(request->hRequest, NULL)) {
+                    fail_request(request, "Failed to query data available", GetLastError());
+                }
+                break;
+            }
+
+            query_header_utf8(request->hRequest, WINHTTP_QUERY_ETAG,
+                              request->validators.etag, MAX_VALIDATOR_LENGTH);
+            query_header_utf8(request->hRequest, WINHTTP_QUERY_LAST_MODIFIED,
+                              request->validators.last_modified, MAX_VALIDATOR_LENGTH);
+
+            request->streaming = (request->status_code == 200 && !request->batch);
+            if (request->streaming) init_release_parser(&request->parser, &request->repo);
+
+            if (!WinHttpQueryDataAvailable(request->hRequest, NULL)) {
+                fail_request(request, "Failed to query data available", GetLastError());
+            }
+            break;
+        }
+
+        case WINHTTP_CALLBACK_STATUS_DATA_AVAILABLE:
+            if (value == 0) {
+                complete_request(request);
+                break;
+            }
+
+            if (request->streaming || request->discarding) {
+                // One fixed read buffer; the parser keeps what it needs from each
+                // chunk, and nothing is kept of a discarded body
+                if (!request->response) {
+                    request->response = malloc(FETCH_RESPONSE_INITIAL_CAPACITY);
+                    if (!request->response) {
+                        fail_request(request, "Out of memory reading response", ERROR_NOT_ENOUGH_MEMORY);
+                        break;
+                    }
+                    request->response_capacity = FETCH_RESPONSE_INITIAL_CAPACITY;
+                }
+                if (value > request->response_capacity - 1) value = request->response_capacity - 1;
+                if (!WinHttpReadData(request->hRequest, request->response, value, NULL)) {
+                    fail_request(request, "Failed to read data", GetLastError());
+                }
+                break;
+            }
+
+            if (request->response_len + value + 1 > request->response_capacity) {
+                DWORD new_capacity = request->response_capacity ? request->response_capacity
+                                                                : FETCH_RESPONSE_INITIAL_CAPACITY;
+                while (new_capacity < request->response_len + value + 1) new_capacity *= 2;
+
+                char* new_response = realloc(request->response, new_capacity);
+                if (!new_response) {
+                    fail_request(request, "Out of memory reading response", ERROR_NOT_ENOUGH_MEMORY);
+                    break;
+                }
+                request->response = new_response;
+                request->response_capacity = new_capacity;
+            }
+
+            if (!WinHttpReadData(request->hRequest, request->response + request->response_len,
+                                 value, NULL)) {
+                fail_request(request, "Failed to read data", GetLastError());
+            }
+            break;
+
+        case WINHTTP_CALLBACK_STATUS_READ_COMPLETE:
+            request->body_received += value;
+            if (request->streaming) {
+                if (!feed_release_parser(&request->parser, request->response, value)) {
+                    fail_request(request, "Malformed release JSON", ERROR_INVALID_DATA);
+                    break;
+                }
+            } else if (!request->discarding) {
+                request->response_len += value;
+            }
+            if (value == 0) {
+                complete_request(request);
+            } else if (!WinHttpQueryDataAvailable(request->hRequest, NULL)) {
+                fail_request(request, "Failed to query data available", GetLastError());
+            }
+            break;
+
+        case WINHTTP_CALLBACK_STATUS_REQUEST_ERROR:
+            fail_request(request, "HTTP request failed", value);
+            break;
+    }
+}
+
+static void dispatch_pending(FetchEngine* engine) {
+    engine->wait_ms = INFINITE;
+
+    while (engine->in_flight < engine->max_in_flight) {
+        HttpConnection* conn = NULL;
+        long long wait_ms = 0;
+
+        EnterCriticalSection(&engine->mutex);
+        FetchRequest* request = engine->pending_head;
+        if (request) {
+            conn = http_pool_acquire();
+            if (conn && !scheduler_acquire(&wait_ms)) {
+                // Out of quota: keep the request queued and come back later
+                http_pool_release(conn);
+                conn = NULL;
+                engine->wait_ms = wait_ms > 0 ? (DWORD)wait_ms : 1000;
+            } else if (conn) {
+                engine->pending_head = request->next;
+                if (!engine->pending_head) engine->pending_tail = NULL;
+                request->next = NULL;
+            }
+        }
+        LeaveCriticalSection(&engine->mutex);
+
+        if (!request || !conn) break;
+        start_request(engine, request, conn);
+    }
+}
+
+static void cancel_all(FetchEngine* engine) {
+    EnterCriticalSection(&engine->mutex);
+    FetchRequest* request = engine->pending_head;
+    engine->pending_head = engine->pending_tail = NULL;
+    LeaveCriticalSection(&engine->mutex);
+
+    while (request) {
+        FetchRequest* next = request->next;
+        scheduler_on_finished(false);
+        free_request(request);
+        request = next;
+    }
+
+    for (int i = 0; i < engine->max_in_flight; i++) {
+        if (engine->active[i]) close_request(engine->active[i]);
+    }
+}
+
+static unsigned __stdcall engine_thread(void* arg) {
+    FetchEngine* engine = (FetchEngine*)arg;
+
+    for (;;) {
+        DWORD value = 0;
+        ULONG_PTR key = 0;
+        LPOVERLAPPED overlapped = NULL;
+
+        if (!GetQueuedCompletionStatus(engine->iocp, &value, &key, &overlapped, engine->wait_ms)) {
+            // A timeout means the scheduler pause is over; anything else is fatal
+            if (overlapped || GetLastError() != WAIT_TIMEOUT) break;
+            key = ENGINE_WAKE_KEY;
+        }
+
+        if (key != ENGINE_WAKE_KEY) {
+            handle_event((FetchRequest*)key, (DWORD)(ULONG_PTR)overlapped, value);
+        }
+
+        if (engine->stopping) {
+            cancel_all(engine);
+            if (engine->in_flight == 0) break;
+        } else {
+            dispatch_pending(engine);
+        }
+    }
+
+    return 0;
+}
+
+FetchEngine* create_fetch_engine(int max_in_flight, ReleaseQueue* results, const char* auth_token) {
+    if (max_in_flight < 1) max_in_flight = 1;
+
+    FetchEngine* engine = calloc(1, sizeof(FetchEngine));
+    if (!engine) return NULL;
+
+    engine->active = calloc(max_in_flight, sizeof(FetchRequest*));
+    engine->iocp = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+    if (!engine->active || !engine->iocp) {
+        if (engine->iocp) CloseHandle(engine->iocp);
+        free(engine->active);
+        free(engine);
+        return NULL;
+    }
+
+    engine->max_in_flight = max_in_flight;
+    engine->wait_ms = INFINITE;
+    engine->results = results;
+    InitializeCriticalSection(&engine->mutex);
+
+    // Every request carries the same headers, so build them once
+    swprintf(engine->headers, sizeof(engine->headers)/sizeof(wchar_t),
+             L"Authorization: Bearer %hs\r\n"
+             L"User-Agent: GReleaseMon-c/1.0\r\n"
+             L"Accept: application/vnd.github.v3+json\r\n",
+             auth_token);
+
+    engine->thread = (HANDLE)_beginthreadex(NULL, 0, engine_thread, engine, 0, NULL);
+    if (engine->thread == 0) {
+        DeleteCriticalSection(&engine->mutex);
+        CloseHandle(engine->iocp);
+        free(engine->active);
+        free(engine);
+        return NULL;
+    }
+
+    return engine;
+}
+
+// Cancels queued and in-flight requests and waits for WinHTTP to let go of them
+void free_fetch_engine(FetchEngine* engine) {
+    if (!engine) return;
+
+    InterlockedExchange(&engine->stopping, 1);
+    PostQueuedCompletionStatus(engine->iocp, 0, ENGINE_WAKE_KEY, NULL);
+    WaitForSingleObject(engine->thread, INFINITE);
+    CloseHandle(engine->thread);
+
+    CloseHandle(engine->iocp);
+    DeleteCriticalSection(&engine->mutex);
+    free(engine->active);
+    free(engine);
+}
+
+static void enqueue_request(FetchEngine* engine, FetchRequest* request) {
+    scheduler_add_pending(1);
+
+    EnterCriticalSection(&engine->mutex);
+    if (engine->pending_tail) {
+        engine->pending_tail->next = request;
+    } else {
+        engine->pending_head = request;
+    }
+    engine->pending_tail = request;
+    LeaveCriticalSection(&engine->mutex);
+
+    PostQueuedCompletionStatus(engine->iocp, 0, ENGINE_WAKE_KEY, NULL);
+}
+
+bool submit_fetch(FetchEngine* engine, const RepoInfo* repo) {
+    FetchRequest* request = calloc(1, sizeof(FetchRequest));
+    if (!request) return false;
+
+    request->engine = engine;
+    request->repo = *repo;
+    request->state = FETCH_STATE_QUEUED;
+    init_rate_limit_headers(&request->rate_limit);
+
+    enqueue_request(engine, request);
+    return true;
+}
+
+// Queue one GraphQL request answering latestRelease for up to
+// GRAPHQL_BATCH_SIZE repositories
+bool submit_graphql_batch(FetchEngine* engine, const RepoInfo* repos, int count) {
+    FetchRequest* request = calloc(1, sizeof(FetchRequest));
+    if (!request) return false;
+
+    request->engine = engine;
+    request->repo = repos[0];
+    request->batch = malloc(count * sizeof(RepoInfo));
+    request->post_body = build_graphql_batch_query(repos, count);
+    if (!request->batch || !request->post_body) {
+        free_request(request);
+        return false;
+    }
+    memcpy(request->batch, repos, count * sizeof(RepoInfo));
+    request->batch_count = count;
+    request->post_body_len = (DWORD)strlen(request->post_body);
+    request->state = FETCH_STATE_QUEUED;
+    init_rate_limit_headers(&request->rate_limit);
+
+    enqueue_request(engine, request);
+    return true;
+}
+
+#endif // _WIN32
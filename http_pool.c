@@ -0,0 +1,187 @@
+#include "http_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <winhttp.h>
+#pragma comment(lib, "winhttp.lib")
+#else
+#include <openssl/ssl.h>
+#endif
+
+static HttpConnection g_connections[HTTP_POOL_MAX_CONNECTIONS];
+static int g_connection_count = 0;
+static bool g_initialized = false;
+static CRITICAL_SECTION g_pool_mutex;
+
+#ifdef _WIN32
+#define HTTP_WIDEN_(s) L ## s
+#define HTTP_WIDEN(s) HTTP_WIDEN_(s)
+
+// Process-wide asynchronous WinHTTP session shared by every fetch
+static HINTERNET g_session = NULL;
+
+static bool http_pool_open_transport(int max_connections) {
+    g_session = WinHttpOpen(L"GReleaseMon-c/1.0",
+                           WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
+                           WINHTTP_NO_PROXY_NAME,
+                           WINHTTP_NO_PROXY_BYPASS,
+                           WINHTTP_FLAG_ASYNC);
+    if (!g_session) {
+        fprintf(stderr, "Error: Failed to initialize WinHTTP\n");
+        return false;
+    }
+
+    // WinHTTP pools sockets itself, per session and host; the connect handles
+    // below are only lookups and do not bound them. Cap the session so no
+    // more than connections= sockets are open to the API, as on POSIX.
+    DWORD max_conns = (DWORD)max_connections;
+    if (!WinHttpSetOption(g_session, WINHTTP_OPTION_MAX_CONNS_PER_SERVER, &max_conns, sizeof(max_conns)) ||
+        !WinHttpSetOption(g_session, WINHTTP_OPTION_MAX_CONNS_PER_1_0_SERVER, &max_conns, sizeof(max_conns))) {
+        fprintf(stderr, "Warning: Failed to limit WinHTTP to %d connections (%lu)\n",
+                max_connections, GetLastError());
+    }
+
+    for (int i = 0; i < max_connections; i++) {
+        g_connections[i].hConnect = WinHttpConnect(g_session, HTTP_WIDEN(GITHUB_API_HOST),
+                                                   GITHUB_API_PORT, 0);
+        if (!g_connections[i].hConnect) {
+            fprintf(stderr, "Error: Failed to connect to GitHub API\n");
+            return false;
+        }
+        g_connection_count++;
+    }
+    return true;
+}
+
+static void http_pool_close_transport(void) {
+    for (int i = 0; i < g_connection_count; i++) {
+        if (g_connections[i].hConnect) {
+            WinHttpCloseHandle(g_connections[i].hConnect);
+        }
+    }
+
+    if (g_session) {
+        WinHttpCloseHandle(g_session);
+        g_session = NULL;
+    }
+}
+#else
+// TLS context shared by every pooled socket
+static SSL_CTX* g_tls_context = NULL;
+
+static bool http_pool_open_transport(int max_connections) {
+    g_tls_context = SSL_CTX_new(TLS_client_method());
+    if (!g_tls_context) {
+        fprintf(stderr, "Error: Failed to initialize TLS\n");
+        return false;
+    }
+    SSL_CTX_set_verify(g_tls_context, SSL_VERIFY_PEER, NULL);
+    SSL_CTX_set_default_verify_paths(g_tls_context);
+
+    for (int i = 0; i < max_connections; i++) {
+        g_connections[i].fd = -1;
+        g_connection_count++;
+    }
+    return true;
+}
+
+static void http_pool_close_transport(void) {
+    for (int i = 0; i < g_connection_count; i++) {
+        http_pool_disconnect(&g_connections[i]);
+    }
+
+    if (g_tls_context) {
+        SSL_CTX_free(g_tls_context);
+        g_tls_context = NULL;
+    }
+}
+
+SSL_CTX* http_pool_tls_context(void) {
+    return g_tls_context;
+}
+
+// Drop the socket; the next request on this slot opens a new one
+void http_pool_disconnect(HttpConnection* conn) {
+    if (conn->ssl) {
+        SSL_free(conn->ssl);
+        conn->ssl = NULL;
+    }
+    if (conn->fd >= 0) {
+        close(conn->fd);
+        conn->fd = -1;
+    }
+}
+#endif
+
+bool http_pool_init(int max_connections) {
+    if (g_initialized) return true;
+
+    if (max_connections < 1) max_connections = 1;
+    if (max_connections > HTTP_POOL_MAX_CONNECTIONS) max_connections = HTTP_POOL_MAX_CONNECTIONS;
+
+    memset(g_connections, 0, sizeof(g_connections));
+    InitializeCriticalSection(&g_pool_mutex);
+    g_initialized = true;
+
+    if (!http_pool_open_transport(max_connections)) {
+        http_pool_cleanup();
+        return false;
+    }
+
+    return true;
+}
+
+void http_pool_cleanup(void) {
+    if (!g_initialized) return;
+
+    http_pool_close_transport();
+    DeleteCriticalSection(&g_pool_mutex);
+
+    memset(g_connections, 0, sizeof(g_connections));
+    g_connection_count = 0;
+    g_initialized = false;
+}
+
+// Hand out a free connection, or NULL when every connection is busy
+HttpConnection* http_pool_acquire(void) {
+    if (!g_initialized) return NULL;
+
+    HttpConnection* conn = NULL;
+    EnterCriticalSection(&g_pool_mutex);
+    for (int i = 0; i < g_connection_count; i++) {
+        if (!g_connections[i].in_use) {
+            conn = &g_connections[i];
+            conn->in_use = true;
+            break;
+        }
+    }
+    LeaveCriticalSection(&g_pool_mutex);
+    return conn;
+}
+
+void http_pool_release(HttpConnection* conn) {
+    if (!conn) return;
+
+    EnterCriticalSection(&g_pool_mutex);
+    conn->in_use = false;
+    LeaveCriticalSection(&g_pool_mutex);
+}
+
+void http_pool_get_stats(HttpPoolStats* stats) {
+    memset(stats, 0, sizeof(HttpPoolStats));
+    stats->connection_count = g_connection_count;
+
+    for (int i = 0; i < g_connection_count; i++) {
+        stats->total_requests += g_connections[i].requests_served;
+        stats->total_handshakes += g_connections[i].handshakes;
+    }
+}
+
+bool http_pool_get_connection_stats(int index, long* requests_served, long* handshakes) {
+    if (index < 0 || index >= g_connection_count) return false;
+
+    if (requests_served) *requests_served = g_connections[index].requests_served;
+    if (handshakes) *handshakes = g_connections[index].handshakes;
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef HTTP_POOL_H
+#define HTTP_POOL_H
+
+#include <stdbool.h>
+#include "platform.h"
+#ifdef _WIN32
+#include <winhttp.h>
+#endif
+
+#define HTTP_POOL_DEFAULT_CONNECTIONS 32
+#define HTTP_POOL_MAX_CONNECTIONS 256
+
+// Override at build time to point the client at a stand-in server
+#ifndef GITHUB_API_HOST
+#define GITHUB_API_HOST "api.github.com"
+#endif
+#ifndef GITHUB_API_PORT
+#define GITHUB_API_PORT 443
+#endif
+
+struct ssl_st;
+struct ssl_ctx_st;
+
+// One pooled keep-alive connection to api.github.com
+typedef struct {
+#ifdef _WIN32
+    HINTERNET hConnect;
+#else
+    int fd;                 // -1 while no socket is open
+    struct ssl_st* ssl;
+#endif
+    bool in_use;
+    volatile LONG requests_served;  // Requests sent over this connection
+    volatile LONG handshakes;       // New TCP/TLS connections opened for it
+} HttpConnection;
+
+typedef struct {
+    int connection_count;
+    long total_requests;
+    long total_handshakes;
+} HttpPoolStats;
+
+// Function declarations
+bool http_pool_init(int max_connections);
+void http_pool_cleanup(void);
+HttpConnection* http_pool_acquire(void);
+void http_pool_release(HttpConnection* conn);
+void http_pool_get_stats(HttpPoolStats* stats);
+bool http_pool_get_connection_stats(int index, long* requests_served, long* handshakes);
+
+#ifndef _WIN32
+struct ssl_ctx_st* http_pool_tls_context(void);
+void http_pool_disconnect(HttpConnection* conn);
+#endif
+
+#endif // HTTP_POOL_H
@@ -0,0 +1,273 @@
+#include "json_scan.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define JSON_SCAN_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC compiles any intrinsic; GCC and Clang need the target per function
+#if defined(JSON_SCAN_X86) && !defined(_MSC_VER)
+#define JSON_TARGET_SSE2 __attribute__((target("sse2")))
+#define JSON_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define JSON_TARGET_SSE2
+#define JSON_TARGET_AVX2
+#endif
+
+#define INDEX_BLOCK_SIZE 4096
+
+// Append the positions of structural characters in data[0..len) to out
+typedef size_t (*IndexKernel)(const char* data, size_t len, unsigned int base, unsigned int* out);
+// Offset of the first quote or backslash in data[0..len), or len
+typedef size_t (*StringKernel)(const char* data, size_t len);
+
+static IndexKernel g_index_kernel = NULL;
+static StringKernel g_string_kernel = NULL;
+static const char* g_kernel_name = "scalar";
+
+static bool is_structural(char c) {
+    // '[' and '{', ']' and '}' differ only in bit 0x20
+    char folded = (char)(c | 0x20);
+    return c == '"' || c == '\\' || c == ',' || folded == '{' || folded == '}';
+}
+
+static size_t index_scalar(const char* data, size_t len, unsigned int base, unsigned int* out) {
+    size_t count = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (is_structural(data[i])) out[count++] = base + (unsigned int)i;
+    }
+    return count;
+}
+
+static size_t string_scalar(const char* data, size_t len) {
+    size_t i = 0;
+    while (i < len && data[i] != '"' && data[i] != '\\') i++;
+    return i;
+}
+
+#ifdef JSON_SCAN_X86
+static int lowest_bit(unsigned int mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+static size_t emit_positions(unsigned int mask, unsigned int base, unsigned int* out) {
+    size_t count = 0;
+    while (mask) {
+        out[count++] = base + (unsigned int)lowest_bit(mask);
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+JSON_TARGET_SSE2
+static unsigned int structural_mask_sse2(__m128i chunk) {
+    __m128i folded = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+    __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')),
+                                _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(',')));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(folded, _mm_set1_epi8('{')));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(folded, _mm_set1_epi8('}')));
+    return (unsigned int)_mm_movemask_epi8(hits);
+}
+
+JSON_TARGET_SSE2
+static size_t index_sse2(const char* data, size_t len, unsigned int base, unsigned int* out) {
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+        count += emit_positions(structural_mask_sse2(chunk), base + (unsigned int)i, out + count);
+    }
+    return count + index_scalar(data + i, len - i, base + (unsigned int)i, out + count);
+}
+
+JSON_TARGET_SSE2
+static size_t string_sse2(const char* data, size_t len) {
+    size_t i = 0;
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')),
+                                    _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(hits);
+        if (mask) return i + lowest_bit(mask);
+    }
+    return i + string_scalar(data + i, len - i);
+}
+
+JSON_TARGET_AVX2
+static size_t index_avx2(const char* data, size_t len, unsigned int base, unsigned int* out) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i open = _mm256_set1_epi8('{');
+    const __m256i close = _mm256_set1_epi8('}');
+    const __m256i fold = _mm256_set1_epi8(0x20);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 32 <= len; i += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i folded = _mm256_or_si256(chunk, fold);
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                                       _mm256_cmpeq_epi8(chunk, backslash));
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(chunk, comma));
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(folded, open));
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(folded, close));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(hits);
+        count += emit_positions(mask, base + (unsigned int)i, out + count);
+    }
+    return count + index_sse2(data + i, len - i, base + (unsigned int)i, out + count);
+}
+
+JSON_TARGET_AVX2
+static size_t string_avx2(const char* data, size_t len) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    size_t i = 0;
+
+    for (; i + 32 <= len; i += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                                       _mm256_cmpeq_epi8(chunk, backslash));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(hits);
+        if (mask) return i + lowest_bit(mask);
+    }
+    return i + string_sse2(data + i, len - i);
+}
+
+static bool cpu_has_sse2(void) {
+#if defined(_M_X64) || defined(__x86_64__)
+    return true;  // Part of the x86-64 baseline
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+static bool cpu_has_avx2(void) {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    // The OS must also save the YMM registers on context switches
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 6) != 6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif // JSON_SCAN_X86
+
+// Pick the widest kernel this CPU supports. Racing first callers all store
+// the same pointers, so no lock is needed.
+static void select_kernels(void) {
+    IndexKernel index_kernel = index_scalar;
+    StringKernel string_kernel = string_scalar;
+    const char* name = "scalar";
+
+#ifdef JSON_SCAN_X86
+    if (cpu_has_avx2()) {
+        index_kernel = index_avx2;
+        string_kernel = string_avx2;
+        name = "avx2";
+    } else if (cpu_has_sse2()) {
+        index_kernel = index_sse2;
+        string_kernel = string_sse2;
+        name = "sse2";
+    }
+#endif
+
+    g_kernel_name = name;
+    g_string_kernel = string_kernel;
+    g_index_kernel = index_kernel;
+}
+
+// Pin one kernel by name instead of the widest one, for tests and benchmarks
+bool json_scan_use_kernel(const char* name) {
+    if (strcmp(name, "scalar") == 0) {
+        g_index_kernel = index_scalar;
+        g_string_kernel = string_scalar;
+        g_kernel_name = "scalar";
+        return true;
+    }
+#ifdef JSON_SCAN_X86
+    if (strcmp(name, "sse2") == 0 && cpu_has_sse2()) {
+        g_index_kernel = index_sse2;
+        g_string_kernel = string_sse2;
+        g_kernel_name = "sse2";
+        return true;
+    }
+    if (strcmp(name, "avx2") == 0 && cpu_has_avx2()) {
+        g_index_kernel = index_avx2;
+        g_string_kernel = string_avx2;
+        g_kernel_name = "avx2";
+        return true;
+    }
+#endif
+    return false;
+}
+
+const char* json_scan_kernel_name(void) {
+    if (!g_index_kernel) select_kernels();
+    return g_kernel_name;
+}
+
+size_t json_scan_string(const char* data, size_t len) {
+    if (!g_string_kernel) select_kernels();
+    return g_string_kernel(data, len);
+}
+
+// Build the structural index block by block, so the positions array grows
+// with the number of structural characters rather than the document size
+bool json_build_index(const char* json, size_t len, JsonIndex* index) {
+    if (!g_index_kernel) select_kernels();
+
+    index->count = 0;
+    if (len > 0xFFFFFFFFu) return false;
+
+    for (size_t offset = 0; offset < len; offset += INDEX_BLOCK_SIZE) {
+        size_t block = len - offset < INDEX_BLOCK_SIZE ? len - offset : INDEX_BLOCK_SIZE;
+
+        if (index->count + block > index->capacity) {
+            size_t new_capacity = index->capacity ? index->capacity : INDEX_BLOCK_SIZE;
+            while (new_capacity < index->count + block) new_capacity *= 2;
+
+            unsigned int* new_positions = realloc(index->positions, new_capacity * sizeof(unsigned int));
+            if (!new_positions) return false;
+            index->positions = new_positions;
+            index->capacity = new_capacity;
+        }
+
+        index->count += g_index_kernel(json + offset, block, (unsigned int)offset,
+                                       index->positions + index->count);
+    }
+    return true;
+}
+
+void free_json_index(JsonIndex* index) {
+    free(index->positions);
+    index->positions = NULL;
+    index->count = index->capacity = 0;
+}
@@ -0,0 +1,23 @@
+#ifndef JSON_SCAN_H
+#define JSON_SCAN_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// Positions of the structural characters in a document: quotes, backslashes,
+// brackets, braces and commas, in ascending order. Characters inside strings
+// are included too; the tokenizer skips them while walking a string.
+typedef struct {
+    unsigned int* positions;
+    size_t count;
+    size_t capacity;
+} JsonIndex;
+
+// Function declarations
+bool json_build_index(const char* json, size_t len, JsonIndex* index);
+void free_json_index(JsonIndex* index);
+size_t json_scan_string(const char* data, size_t len);
+const char* json_scan_kernel_name(void);
+bool json_scan_use_kernel(const char* name);    // "scalar", "sse2" or "avx2"; false if unavailable
+
+#endif // JSON_SCAN_H
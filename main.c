@@ -1,20 +1,29 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <Windows.h>
-#include <process.h>
-#include <conio.h>
+#include <signal.h>
+#include "platform.h"
 #include "config.h"
 #include "requests.h"
 #include "ui.h"
 #include "release_page.h"
 #include "utils.h"
+#include "http_pool.h"
+#include "fetch_engine.h"
+#include "release_cache.h"
+#include "scheduler.h"
+#include "asset_classifier.h"
+#include "release_queue.h"
+#include "string_table.h"
+
+#define STATUS_REFRESH_MS 500
 
 // Global variables
 static volatile bool g_running = true;
 static UIState* g_ui_state = NULL;
 static ReleasePage* g_current_release_page = NULL;
 
+#ifdef _WIN32
 // Console control handler for clean shutdown
 BOOL WINAPI console_handler(DWORD dwCtrlType) {
     switch (dwCtrlType) {
@@ -29,45 +38,76 @@ BOOL WINAPI console_handler(DWORD dwCtrlType) {
             return FALSE;
     }
 }
+#else
+// Ctrl+C, kill or a dropped SSH session: give the terminal back and exit
+static void signal_handler(int signal_number) {
+    (void)signal_number;
+    cleanup_ui();
+    _exit(0);
+}
+#endif
 
-// Thread function for updating the display periodically
-unsigned __stdcall update_thread(void* arg) {
-    UIState* state = (UIState*)arg;
+// Pull finished fetches into the table. The collection belongs to this
+// thread alone, so rendering never waits on the fetch threads. An open
+// release page holds a record number, which new arrivals never change.
+static void refresh_table(ReleaseQueue* results, UIState* state) {
+    int added = drain_release_queue(results, state->releases);
+    if (added > 0) apply_filters(state);
+    if (!shows_table(state)) return;
     
-    while (g_running) {
-        // Update the display every 500ms if new data is available
-        msleep(500);
-        
-        if (state->current_mode == MODE_TABLE) {
-            // Check if we need to resort
-            static int last_count = 0;
-            EnterCriticalSection(&state->releases->mutex);
-            int current_count = state->releases->count;
-            LeaveCriticalSection(&state->releases->mutex);
-            
-            if (current_count != last_count) {
-                sort_releases_by_date(state->releases);
-                update_display(state);
-                last_count = current_count;
-            }
-        }
+    if (added > 0) {
+        update_display(state);
+    } else if (state->status_live && GetTickCount() - state->status_drawn >= STATUS_REFRESH_MS) {
+        // Keep the pending count and ETA moving while requests are out
+        draw_status_line(state);
     }
     
-    return 0;
+    // Ages such as "3h ago" move on by themselves; redraw just those cells
+    refresh_ages(state);
+}
+
+// How long the loop may sleep before the screen changes on its own: the
+// next age cell to expire, and the status line while requests are
+// outstanding. Keys and arrivals wake it earlier.
+static int get_wait_timeout(const UIState* state) {
+    if (!shows_table(state)) return TERMINAL_WAIT_FOREVER;
+    
+    time_t now = time(NULL);
+    if (state->ages_expire <= now) return 0;
+    int timeout = (int)(state->ages_expire - now) * 1000;   // At most a day
+    
+    // Stays live until a redraw finds nothing outstanding, so the last
+    // request is seen leaving
+    if (state->status_live) {
+        DWORD elapsed = GetTickCount() - state->status_drawn;
+        int status_due = elapsed >= STATUS_REFRESH_MS ? 0 : (int)(STATUS_REFRESH_MS - elapsed);
+        if (status_due < timeout) timeout = status_due;
+    }
+    return timeout;
 }
 
 int main(int argc, char* argv[]) {
     ErrorCode error = SUCCESS;
     Config* config = NULL;
     ReleaseCollection* releases = NULL;
-    HANDLE* fetch_threads = NULL;
-    HANDLE update_thread_handle;
-    FetchThreadData* thread_data = NULL;
+    ReleaseQueue* results = NULL;
+    FetchEngine* engine = NULL;
+    int connection_count = 0;
     
     // Set up console control handler
+#ifdef _WIN32
     SetConsoleCtrlHandler(console_handler, TRUE);
+#else
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+    signal(SIGHUP, signal_handler);
+#endif
     
-    // Initialize WinHTTP (no global init needed)
+    // Repository, owner and tag names are interned from the config onwards
+    if (!string_table_init()) {
+        error = ERROR_OUT_OF_MEMORY;
+        goto cleanup;
+    }
     
     // Load configuration
     char* config_path = get_config_path();
@@ -88,15 +128,40 @@ int main(int argc, char* argv[]) {
         goto cleanup;
     }
     
+    connection_count = config->connection_count > 0 ? config->connection_count
+                                                     : HTTP_POOL_DEFAULT_CONNECTIONS;
+    
+    // Open the shared HTTP session (WinHTTP or OpenSSL) and its keep-alive connection pool
+    if (!http_pool_init(connection_count)) {
+        error = ERROR_HTTP_INIT;
+        goto cleanup;
+    }
+    
+    // Pace requests against the API rate limit
+    scheduler_init();
+    
+    // Compile the asset name patterns before any response can arrive
+    if (!asset_classifier_init(config->asset_patterns, config->asset_pattern_count)) {
+        error = ERROR_OUT_OF_MEMORY;
+        goto cleanup;
+    }
+    
+    // Load validators and releases from the previous run for conditional requests
+    load_release_cache(get_cache_path());
+    
     // Create release collection
     releases = create_release_collection(config->repo_count);
-    if (!releases) {
+    results = create_release_queue();
+    if (!releases || !results) {
         error = ERROR_OUT_OF_MEMORY;
         goto cleanup;
     }
     
     // Initialize UI
-    init_ui();
+    if (!init_ui()) {
+        error = ERROR_UI_INIT;
+        goto cleanup;
+    }
     g_ui_state = create_ui_state(config, releases);
     if (!g_ui_state) {
         cleanup_ui();
@@ -107,37 +172,42 @@ int main(int argc, char* argv[]) {
     // Initial display
     update_display(g_ui_state);
     
-    // Allocate memory for threads
-    fetch_threads = calloc(config->repo_count, sizeof(HANDLE));
-    thread_data = calloc(config->repo_count, sizeof(FetchThreadData));
-    if (!fetch_threads || !thread_data) {
-        error = ERROR_OUT_OF_MEMORY;
+    // Start the fetch engine and queue every repository
+    engine = create_fetch_engine(connection_count, results, config->pat);
+    if (!engine) {
+        error = ERROR_HTTP_INIT;
         goto cleanup;
     }
     
-    // Start fetching releases in parallel
-    for (int i = 0; i < config->repo_count; i++) {
-        thread_data[i].repo = config->repos[i];
-        thread_data[i].collection = releases;
-        thread_data[i].auth_token = config->pat;
-        
-        fetch_threads[i] = (HANDLE)_beginthreadex(NULL, 0, fetch_release_thread, &thread_data[i], 0, NULL);
-        if (fetch_threads[i] == 0) {
-            log_message("Failed to create thread for %s/%s", 
-                       config->repos[i].owner, config->repos[i].repo);
+    if (config->use_graphql) {
+        for (int i = 0; i < config->repo_count; i += GRAPHQL_BATCH_SIZE) {
+            int batch_count = config->repo_count - i;
+            if (batch_count > GRAPHQL_BATCH_SIZE) batch_count = GRAPHQL_BATCH_SIZE;
+            
+            if (!submit_graphql_batch(engine, &config->repos[i], batch_count)) {
+                log_message("Failed to queue GraphQL batch starting at %s/%s", 
+                           config->repos[i].owner, config->repos[i].repo);
+            }
+        }
+    } else {
+        for (int i = 0; i < config->repo_count; i++) {
+            if (!submit_fetch(engine, &config->repos[i])) {
+                log_message("Failed to queue %s/%s", 
+                           config->repos[i].owner, config->repos[i].repo);
+            }
         }
     }
     
-    // Start update thread
-    update_thread_handle = (HANDLE)_beginthreadex(NULL, 0, update_thread, g_ui_state, 0, NULL);
-    
-    // Main event loop
+    // Main event loop: sleep until a key, a release or a redraw is due
     while (g_running) {
-        if (_kbhit()) {
+        terminal_wait(get_release_queue_wait_handle(results), get_wait_timeout(g_ui_state));
+        
+        if (terminal_key_ready()) {
             int ch = getch();
             
-            // Global key handlers
-            if (ch == 'x' || ch == 'X' || ch == 17) { // 17 = Ctrl+Q
+            // Global key handlers; while searching, x is just a letter
+            if (ch == KEY_CTRL_Q ||
+                ((ch == 'x' || ch == 'X') && g_ui_state->current_mode != MODE_SEARCH)) {
                 g_running = false;
                 break;
             }
@@ -148,28 +218,32 @@ int main(int argc, char* argv[]) {
                     
                     // Check if we need to show release page
                     if (g_ui_state->current_mode == MODE_RELEASE_PAGE) {
-                        EnterCriticalSection(&releases->mutex);
-                        if (g_ui_state->selected_row > 0 &&
-                            g_ui_state->selected_row <= releases->count) {
-                            Release* selected = &releases->releases[g_ui_state->selected_row - 1];
-                            
+                        int selected = get_selected_release_id(g_ui_state);
+                        if (selected >= 0) {
                             // Clean up old release page
                             if (g_current_release_page) {
                                 free_release_page(g_current_release_page);
                             }
                             
                             // Create new release page
-                            g_current_release_page = create_release_page(selected);
+                            g_current_release_page = create_release_page(releases, selected);
                             if (g_current_release_page) {
                                 display_release_page(g_current_release_page, g_ui_state);
                             } else {
                                 g_ui_state->current_mode = MODE_TABLE;
                             }
                         }
-                        LeaveCriticalSection(&releases->mutex);
                     }
                     break;
                     
+                case MODE_SEARCH:
+                    handle_search_input(g_ui_state, ch);
+                    break;
+                    
+                case MODE_GOTO:
+                    handle_goto_input(g_ui_state, ch);
+                    break;
+                    
                 case MODE_RELEASE_PAGE:
                     if (g_current_release_page) {
                         handle_release_input(g_current_release_page, g_ui_state, ch);
@@ -185,21 +259,18 @@ int main(int argc, char* argv[]) {
             }
         }
         
-        // Small delay to prevent high CPU usage
-        msleep(10);
+        refresh_table(results, g_ui_state);
+        
+        // One frame per pass: whatever was drawn above, only what changed
+        flush_screen(g_ui_state->screen);
     }
     
-    // Wait for update thread to complete
-    WaitForSingleObject(update_thread_handle, INFINITE);
-    CloseHandle(update_thread_handle);
+    // Cancel outstanding fetches
+    free_fetch_engine(engine);
+    engine = NULL;
     
-    // Wait for all fetch threads to complete
-    for (int i = 0; i < config->repo_count; i++) {
-        if (fetch_threads[i]) {
-            WaitForSingleObject(fetch_threads[i], INFINITE);
-            CloseHandle(fetch_threads[i]);
-        }
-    }
+    // Persist validators for the next run
+    save_release_cache(get_cache_path(), config->repos, config->repo_count);
     
 cleanup:
     // Clean up UI
@@ -212,12 +283,17 @@ cleanup:
     cleanup_ui();
     
     // Free resources
-    if (thread_data) free(thread_data);
-    if (fetch_threads) free(fetch_threads);
+    if (engine) free_fetch_engine(engine);
+    if (results) free_release_queue(results);
     if (releases) free_release_collection(releases);
     if (config) free_config(config);
     
-    // Cleanup WinHTTP (no global cleanup needed)
+    // Close pooled connections and the shared session
+    http_pool_cleanup();
+    scheduler_cleanup();
+    asset_classifier_cleanup();
+    free_release_cache();
+    string_table_cleanup();
     
     if (error != SUCCESS) {
         fprintf(stderr, "\nPress any key to exit...\n");
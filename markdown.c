@@ -0,0 +1,255 @@
+#include "markdown.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define MARKDOWN_MAX_INDENT 3           // Deeper than this and a line is not a heading, rule or fence
+#define MARKDOWN_MAX_HEADING 6
+#define MARKDOWN_BULLET_TEXT "\xE2\x80\xA2 "  // "• " in place of "- ", "* " or "+ "
+
+bool init_markdown_text(MarkdownText* out, int capacity) {
+    memset(out, 0, sizeof(MarkdownText));
+    if (capacity < 64) capacity = 64;
+
+    out->text = malloc(capacity);
+    if (!out->text) return false;
+
+    out->text[0] = '\0';
+    out->capacity = capacity;
+    return true;
+}
+
+void free_markdown_text(MarkdownText* out) {
+    free(out->text);
+    free(out->spans);
+    memset(out, 0, sizeof(MarkdownText));
+}
+
+static bool append_raw(MarkdownText* out, const char* text, int length) {
+    if (out->length + length + 1 > out->capacity) {
+        int new_capacity = out->capacity * 2;
+        while (new_capacity < out->length + length + 1) new_capacity *= 2;
+
+        char* new_text = realloc(out->text, new_capacity);
+        if (!new_text) return false;
+        out->text = new_text;
+        out->capacity = new_capacity;
+    }
+
+    memcpy(out->text + out->length, text, length);
+    out->length += length;
+    out->text[out->length] = '\0';
+    return true;
+}
+
+// Open a span only where the style changes, so plain paragraphs stay one span
+static bool set_style(MarkdownText* out, MarkdownStyle style) {
+    // A span nothing was written to yet is replaced rather than kept empty
+    if (out->span_count > 0 && out->spans[out->span_count - 1].start == out->length) {
+        out->span_count--;
+    }
+    if (out->span_count > 0 && out->spans[out->span_count - 1].style == style) return true;
+
+    if (out->span_count >= out->span_capacity) {
+        int new_capacity = out->span_capacity ? out->span_capacity * 2 : 64;
+        MarkdownSpan* new_spans = realloc(out->spans, new_capacity * sizeof(MarkdownSpan));
+        if (!new_spans) return false;
+        out->spans = new_spans;
+        out->span_capacity = new_capacity;
+    }
+
+    out->spans[out->span_count].start = out->length;
+    out->spans[out->span_count].style = style;
+    out->span_count++;
+    return true;
+}
+
+bool append_markdown_text(MarkdownText* out, const char* text, int length, MarkdownStyle style) {
+    if (length <= 0) return true;
+    return set_style(out, style) && append_raw(out, text, length);
+}
+
+static bool starts_with(const char* p, const char* end, const char* prefix) {
+    size_t length = strlen(prefix);
+    return (size_t)(end - p) >= length && memcmp(p, prefix, length) == 0;
+}
+
+// Closing emphasis marker on the rest of the line: not after a space and,
+// for '_', not inside a word, so snake_case names stay as they are
+static const char* find_emphasis_end(const char* p, const char* end, char mark, int count) {
+    for (; p + count <= end; p++) {
+        if (p[0] != mark || (count == 2 && p[1] != mark)) continue;
+        if (p[-1] == ' ') continue;
+        if (mark == '_' && p + count < end && isalnum((unsigned char)p[count])) continue;
+        return p;
+    }
+    return NULL;
+}
+
+// Inline markup of one line. Markers without a partner on the same line
+// are shown as written.
+static bool render_inline(MarkdownText* out, const char* p, const char* end, MarkdownStyle base) {
+    MarkdownStyle emphasis = (base == MARKDOWN_TEXT) ? MARKDOWN_EMPHASIS : base;
+    const char* line = p;
+    const char* plain = p;  // Start of the text not written yet
+
+    while (p < end) {
+        const char* text = NULL;   // Markup found: its text and where it resumes
+        const char* text_end = NULL;
+        const char* resume = NULL;
+        MarkdownStyle style = base;
+        char c = *p;
+
+        if (c == '\\' && p + 1 < end && ispunct((unsigned char)p[1])) {
+            text = p + 1;
+            text_end = resume = p + 2;
+        } else if (c == '`') {
+            // `code` or ``code with a ` in it``
+            int count = starts_with(p, end, "``") ? 2 : 1;
+            for (const char* q = p + count; q + count <= end; q++) {
+                if (memcmp(q, p, count) == 0) {
+                    text = p + count;
+                    text_end = q;
+                    resume = q + count;
+                    style = MARKDOWN_CODE;
+                    break;
+                }
+            }
+        } else if ((c == '*' || c == '_') && (c == '*' || p == line || !isalnum((unsigned char)p[-1]))) {
+            int count = (p + 1 < end && p[1] == c) ? 2 : 1;
+            if (p + count < end && p[count] != ' ') {
+                const char* close = find_emphasis_end(p + count + 1, end, c, count);
+                if (close) {
+                    text = p + count;
+                    text_end = close;
+                    resume = close + count;
+                    style = emphasis;
+                }
+            }
+        } else if (c == '[' || (c == '!' && p + 1 < end && p[1] == '[')) {
+            // [text](url), and ![alt](url) for images: the text, minus the URL
+            const char* label = p + (c == '!' ? 2 : 1);
+            const char* bracket = memchr(label, ']', end - label);
+            if (bracket && bracket + 1 < end && bracket[1] == '(') {
+                const char* paren = memchr(bracket + 2, ')', end - (bracket + 2));
+                if (paren) {
+                    text = label;
+                    text_end = bracket;
+                    resume = paren + 1;
+                    style = MARKDOWN_LINK;
+                }
+            }
+        } else if (c == 'h' && (p == line || !isalnum((unsigned char)p[-1])) &&
+                   (starts_with(p, end, "https://") || starts_with(p, end, "http://"))) {
+            const char* q = p;
+            while (q < end && *q != ' ' && *q != '\t') q++;
+            text = p;
+            text_end = resume = q;
+            style = MARKDOWN_LINK;
+        }
+
+        if (!text) {
+            p++;
+            continue;
+        }
+        if (!append_markdown_text(out, plain, (int)(p - plain), base) ||
+            !append_markdown_text(out, text, (int)(text_end - text), style)) {
+            return false;
+        }
+        p = plain = resume;
+    }
+    return append_markdown_text(out, plain, (int)(end - plain), base);
+}
+
+// ---, *** or ___, optionally spaced out
+static bool is_rule(const char* p, const char* end) {
+    char mark = 0;
+    int count = 0;
+
+    for (; p < end; p++) {
+        if (*p == ' ') continue;
+        if ((*p != '-' && *p != '*' && *p != '_') || (mark && *p != mark)) return false;
+        mark = *p;
+        count++;
+    }
+    return count >= 3;
+}
+
+// Block markup of one line outside code blocks; p is past the indent
+static bool render_line(MarkdownText* out, const char* line, const char* p, const char* end) {
+    int indent = (int)(p - line);
+
+    if (indent <= MARKDOWN_MAX_INDENT && p < end && *p == '#') {
+        const char* text = p;
+        while (text < end && *text == '#') text++;
+        if (text - p <= MARKDOWN_MAX_HEADING && (text == end || *text == ' ')) {
+            while (text < end && *text == ' ') text++;
+
+            // Closing #s are decoration too, but only after a space: "C#" stays
+            const char* text_end = end;
+            while (text_end > text && text_end[-1] == '#') text_end--;
+            if (text_end > text && text_end[-1] != ' ') text_end = end;
+            while (text_end > text && text_end[-1] == ' ') text_end--;
+            return render_inline(out, text, text_end, MARKDOWN_HEADING);
+        }
+    }
+
+    if (indent <= MARKDOWN_MAX_INDENT && is_rule(p, end)) {
+        return append_markdown_text(out, p, (int)(end - p), MARKDOWN_RULE);
+    }
+
+    // Bullets keep their nesting indent; the marker becomes a dot
+    if (p + 1 < end && (*p == '-' || *p == '*' || *p == '+') && p[1] == ' ') {
+        return append_markdown_text(out, line, indent, MARKDOWN_TEXT) &&
+               append_markdown_text(out, MARKDOWN_BULLET_TEXT, (int)strlen(MARKDOWN_BULLET_TEXT), MARKDOWN_BULLET) &&
+               render_inline(out, p + 2, end, MARKDOWN_TEXT);
+    }
+
+    // Numbered items keep their number, "1." or "1)"
+    const char* digits = p;
+    while (digits < end && isdigit((unsigned char)*digits)) digits++;
+    if (digits > p && digits - p <= 9 && digits + 1 < end &&
+        (*digits == '.' || *digits == ')') && digits[1] == ' ') {
+        return append_markdown_text(out, line, indent, MARKDOWN_TEXT) &&
+               append_markdown_text(out, p, (int)(digits + 1 - p), MARKDOWN_BULLET) &&
+               render_inline(out, digits + 1, end, MARKDOWN_TEXT);
+    }
+
+    return render_inline(out, line, end, MARKDOWN_TEXT);
+}
+
+// Append source, rendered, line for line except for code fences, which are
+// dropped in favor of styling the lines between them
+bool render_markdown(MarkdownText* out, const char* source) {
+    bool in_code = false;
+    const char* line = source;
+
+    while (line) {
+        const char* next = strchr(line, '\n');
+        const char* end = next ? next : line + strlen(line);
+        if (end > line && end[-1] == '\r') end--;
+
+        const char* p = line;
+        while (p < end && *p == ' ') p++;
+
+        bool ok = true;
+        if (p - line <= MARKDOWN_MAX_INDENT && (starts_with(p, end, "```") || starts_with(p, end, "~~~"))) {
+            in_code = !in_code;
+            line = next ? next + 1 : NULL;
+            continue;
+        } else if (in_code) {
+            ok = append_markdown_text(out, line, (int)(end - line), MARKDOWN_CODE);
+        } else {
+            ok = render_line(out, line, p, end);
+        }
+
+        if (ok && next) ok = append_raw(out, "\n", 1);
+        if (!ok) {
+            fprintf(stderr, "Error: Failed to allocate memory for release notes\n");
+            return false;
+        }
+        line = next ? next + 1 : NULL;
+    }
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef MARKDOWN_H
+#define MARKDOWN_H
+
+#include <stdbool.h>
+
+// Markdown-lite for release notes: headings, bullet and numbered lists,
+// fenced code blocks, rules, **strong** and *emphasis*, `code`, [links]
+// and bare URLs. Markup is dropped from the text and turned into styles
+// instead, so a page renders its notes once and then only copies them
+// out. Anything else, tables and HTML included, stays as written.
+
+typedef enum {
+    MARKDOWN_TEXT,
+    MARKDOWN_HEADING,
+    MARKDOWN_EMPHASIS,
+    MARKDOWN_CODE,
+    MARKDOWN_LINK,
+    MARKDOWN_BULLET,     // List markers
+    MARKDOWN_RULE,
+    MARKDOWN_STYLE_COUNT
+} MarkdownStyle;
+
+// A style holds from start up to the start of the next span
+typedef struct {
+    int start;
+    MarkdownStyle style;
+} MarkdownSpan;
+
+// Rendered text, grown as it is appended to; both arrays belong to it
+typedef struct {
+    char* text;             // NUL-terminated, lines separated by '\n'
+    int length;
+    int capacity;
+    MarkdownSpan* spans;    // Ascending by start
+    int span_count;
+    int span_capacity;
+} MarkdownText;
+
+// Function declarations
+bool init_markdown_text(MarkdownText* out, int capacity);
+void free_markdown_text(MarkdownText* out);
+bool append_markdown_text(MarkdownText* out, const char* text, int length, MarkdownStyle style);
+bool render_markdown(MarkdownText* out, const char* source);
+
+#endif // MARKDOWN_H
@@ -0,0 +1,50 @@
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+// Maps the Win32 primitives used by the shared code onto POSIX so the same
+// sources build on both. Windows builds just get <Windows.h>.
+#ifdef _WIN32
+#include <Windows.h>
+
+typedef HANDLE WaitHandle;      // Auto-reset event
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef long LONG;
+typedef unsigned long DWORD;
+typedef unsigned short WORD;
+typedef pthread_mutex_t CRITICAL_SECTION;
+typedef int WaitHandle;         // eventfd, readable while signalled
+
+#define InitializeCriticalSection(m) pthread_mutex_init((m), NULL)
+#define DeleteCriticalSection(m)     pthread_mutex_destroy(m)
+#define EnterCriticalSection(m)      pthread_mutex_lock(m)
+#define LeaveCriticalSection(m)      pthread_mutex_unlock(m)
+
+#define InterlockedIncrement(p)      __atomic_add_fetch((p), 1, __ATOMIC_SEQ_CST)
+#define InterlockedDecrement(p)      __atomic_sub_fetch((p), 1, __ATOMIC_SEQ_CST)
+#define InterlockedExchangePointer(p, v) __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+#define ReadPointerAcquire(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define WritePointerRelease(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+// Console attribute bits; screen.c turns them into SGR colors
+#define FOREGROUND_BLUE      0x0001
+#define FOREGROUND_GREEN     0x0002
+#define FOREGROUND_RED       0x0004
+#define FOREGROUND_INTENSITY 0x0008
+#define BACKGROUND_BLUE      0x0010
+#define BACKGROUND_GREEN     0x0020
+#define BACKGROUND_RED       0x0040
+#define BACKGROUND_INTENSITY 0x0080
+
+// Milliseconds since an arbitrary start, wrapping like the Win32 call
+static inline DWORD GetTickCount(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (DWORD)(now.tv_sec * 1000 + now.tv_nsec / 1000000);
+}
+#endif
+
+#endif // PLATFORM_H
@@ -0,0 +1,270 @@
+#include "release_cache.h"
+#include "string_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CACHE_BUCKET_COUNT 1024
+#define CACHE_HEADER "# GReleaseMon release cache v2"   // v1 had escaped tags and a Windows flag
+#define CACHE_FIELD_COUNT 9
+
+typedef struct CacheEntry {
+    char key[2 * MAX_REPO_NAME_LENGTH];  // owner/repo
+    CacheValidators validators;
+    Release release;
+    struct CacheEntry* next;
+} CacheEntry;
+
+static CacheEntry* g_buckets[CACHE_BUCKET_COUNT];
+static bool g_initialized = false;
+static CRITICAL_SECTION g_cache_mutex;
+
+static void ensure_initialized(void) {
+    if (!g_initialized) {
+        InitializeCriticalSection(&g_cache_mutex);
+        g_initialized = true;
+    }
+}
+
+static void make_key(const char* owner, const char* repo, char* key) {
+    snprintf(key, 2 * MAX_REPO_NAME_LENGTH, "%s/%s", owner, repo);
+}
+
+// FNV-1a
+static unsigned int hash_key(const char* key) {
+    unsigned int hash = 2166136261u;
+    while (*key) {
+        hash ^= (unsigned char)*key++;
+        hash *= 16777619u;
+    }
+    return hash % CACHE_BUCKET_COUNT;
+}
+
+static CacheEntry* find_entry(const char* key) {
+    for (CacheEntry* entry = g_buckets[hash_key(key)]; entry; entry = entry->next) {
+        if (strcmp(entry->key, key) == 0) return entry;
+    }
+    return NULL;
+}
+
+static CacheEntry* find_or_add_entry(const char* key) {
+    CacheEntry* entry = find_entry(key);
+    if (entry) return entry;
+
+    entry = calloc(1, sizeof(CacheEntry));
+    if (!entry) return NULL;
+
+    strncpy(entry->key, key, sizeof(entry->key) - 1);
+    unsigned int bucket = hash_key(key);
+    entry->next = g_buckets[bucket];
+    g_buckets[bucket] = entry;
+    return entry;
+}
+
+static void copy_field(char* dest, size_t size, const char* src) {
+    strncpy(dest, src, size - 1);
+    dest[size - 1] = '\0';
+}
+
+// One entry per line, tab separated:
+// owner/repo etag last_modified tag url prerelease created_at platforms body
+// The tag is as shown (git refs cannot hold tabs or newlines), platforms is
+// the ASSET_* mask, and the body is kept JSON-escaped so it has neither.
+static void parse_cache_line(char* line) {
+    char* fields[CACHE_FIELD_COUNT];
+    int count = 0;
+
+    fields[count++] = line;
+    for (char* p = line; *p && count < CACHE_FIELD_COUNT; p++) {
+        if (*p == '\t') {
+            *p = '\0';
+            fields[count++] = p + 1;
+        }
+    }
+    if (count != CACHE_FIELD_COUNT) return;
+
+    char* slash = strchr(fields[0], '/');
+    if (!slash) return;
+
+    CacheEntry* entry = find_or_add_entry(fields[0]);
+    if (!entry) return;
+
+    copy_field(entry->validators.etag, MAX_VALIDATOR_LENGTH, fields[1]);
+    copy_field(entry->validators.last_modified, MAX_VALIDATOR_LENGTH, fields[2]);
+
+    *slash = '\0';
+    entry->release.owner = intern_string(fields[0]);
+    entry->release.repo = intern_string(slash + 1);
+    entry->release.tag = intern_string(fields[3]);
+    entry->release.flags = (fields[5][0] == '1') ? RELEASE_PRERELEASE : 0;
+    entry->release.created_at = (time_t)strtoll(fields[6], NULL, 10);
+    entry->release.platforms = (unsigned char)strtoul(fields[7], NULL, 10);
+    free_release_text(&entry->release);
+    set_release_text(&entry->release, make_string_view(fields[4]), make_string_view(fields[8]));
+}
+
+bool load_release_cache(const char* path) {
+    ensure_initialized();
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;  // First run: nothing cached yet
+
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (size <= 0) {
+        fclose(fp);
+        return false;
+    }
+
+    // Bodies can be very long, so read the file in one go and split it in place
+    char* data = malloc(size + 1);
+    if (!data) {
+        fclose(fp);
+        return false;
+    }
+    size_t read = fread(data, 1, size, fp);
+    data[read] = '\0';
+    fclose(fp);
+
+    if (strncmp(data, CACHE_HEADER, strlen(CACHE_HEADER)) != 0) {
+        fprintf(stderr, "Warning: Ignoring release cache with unknown format: %s\n", path);
+        free(data);
+        return false;
+    }
+
+    EnterCriticalSection(&g_cache_mutex);
+    char* line = data;
+    while (line && *line) {
+        char* next = strchr(line, '\n');
+        if (next) *next++ = '\0';
+
+        size_t len = strlen(line);
+        if (len > 0 && line[len - 1] == '\r') line[len - 1] = '\0';
+        if (line[0] != '#' && line[0] != '\0') parse_cache_line(line);
+
+        line = next;
+    }
+    LeaveCriticalSection(&g_cache_mutex);
+
+    free(data);
+    return true;
+}
+
+// Only repositories still in the config are written, so entries for ones
+// removed from it are dropped rather than carried along forever
+bool save_release_cache(const char* path, const RepoInfo* repos, int repo_count) {
+    if (!g_initialized) return false;
+
+    // Write to a temporary file first so a crash never leaves a torn cache
+    char temp_path[MAX_PATH_LENGTH + 8];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+
+    FILE* fp = fopen(temp_path, "wb");
+    if (!fp) {
+        fprintf(stderr, "Error: Cannot write release cache: %s\n", temp_path);
+        return false;
+    }
+
+    fprintf(fp, "%s\n", CACHE_HEADER);
+
+    EnterCriticalSection(&g_cache_mutex);
+    for (int i = 0; i < repo_count; i++) {
+        char key[2 * MAX_REPO_NAME_LENGTH];
+        make_key(repos[i].owner, repos[i].repo, key);
+        const CacheEntry* entry = find_entry(key);
+        if (!entry) continue;
+
+        const Release* release = &entry->release;
+        StringView url = get_release_url(release);
+        StringView body = get_release_body(release);
+        fprintf(fp, "%s\t%s\t%s\t%s\t%.*s\t%d\t%lld\t%u\t%.*s\n",
+                entry->key,
+                entry->validators.etag,
+                entry->validators.last_modified,
+                get_interned_string(release->tag),
+                url.length, url.data ? url.data : "",
+                (release->flags & RELEASE_PRERELEASE) ? 1 : 0,
+                (long long)release->created_at,
+                release->platforms,
+                body.length, body.data ? body.data : "");
+    }
+    LeaveCriticalSection(&g_cache_mutex);
+
+    bool ok = (fclose(fp) == 0);
+    if (ok) {
+        remove(path);
+        ok = (rename(temp_path, path) == 0);
+    }
+    if (!ok) {
+        fprintf(stderr, "Error: Cannot write release cache: %s\n", path);
+    }
+    return ok;
+}
+
+void free_release_cache(void) {
+    if (!g_initialized) return;
+
+    for (int i = 0; i < CACHE_BUCKET_COUNT; i++) {
+        CacheEntry* entry = g_buckets[i];
+        while (entry) {
+            CacheEntry* next = entry->next;
+            free_release_text(&entry->release);
+            free(entry);
+            entry = next;
+        }
+        g_buckets[i] = NULL;
+    }
+
+    DeleteCriticalSection(&g_cache_mutex);
+    g_initialized = false;
+}
+
+bool release_cache_get_validators(const RepoInfo* repo, CacheValidators* validators) {
+    if (!g_initialized) return false;
+
+    char key[2 * MAX_REPO_NAME_LENGTH];
+    make_key(repo->owner, repo->repo, key);
+
+    EnterCriticalSection(&g_cache_mutex);
+    CacheEntry* entry = find_entry(key);
+    if (entry) *validators = entry->validators;
+    LeaveCriticalSection(&g_cache_mutex);
+
+    return entry != NULL;
+}
+
+// Copy the cached release; the caller owns the copy's details
+bool release_cache_lookup(const RepoInfo* repo, Release* release) {
+    if (!g_initialized) return false;
+
+    char key[2 * MAX_REPO_NAME_LENGTH];
+    make_key(repo->owner, repo->repo, key);
+
+    EnterCriticalSection(&g_cache_mutex);
+    CacheEntry* entry = find_entry(key);
+    if (entry) {
+        copy_release(release, &entry->release);
+    }
+    LeaveCriticalSection(&g_cache_mutex);
+
+    return entry != NULL;
+}
+
+void release_cache_store(const RepoInfo* repo, const CacheValidators* validators, const Release* release) {
+    if (!validators->etag[0] && !validators->last_modified[0]) return;
+
+    ensure_initialized();
+
+    char key[2 * MAX_REPO_NAME_LENGTH];
+    make_key(repo->owner, repo->repo, key);
+
+    EnterCriticalSection(&g_cache_mutex);
+    CacheEntry* entry = find_or_add_entry(key);
+    if (entry) {
+        free_release_text(&entry->release);
+        entry->validators = *validators;
+        copy_release(&entry->release, release);
+    }
+    LeaveCriticalSection(&g_cache_mutex);
+}
@@ -0,0 +1,16 @@
+#ifndef RELEASE_CACHE_H
+#define RELEASE_CACHE_H
+
+#include <stdbool.h>
+#include "config.h"
+#include "requests.h"
+
+// Function declarations
+bool load_release_cache(const char* path);
+bool save_release_cache(const char* path, const RepoInfo* repos, int repo_count);
+void free_release_cache(void);
+bool release_cache_get_validators(const RepoInfo* repo, CacheValidators* validators);
+bool release_cache_lookup(const RepoInfo* repo, Release* release);
+void release_cache_store(const RepoInfo* repo, const CacheValidators* validators, const Release* release);
+
+#endif // RELEASE_CACHE_H
@@ -1,202 +1,290 @@
 #include "release_page.h"
+#include "string_table.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 
-#define INITIAL_LINE_CAPACITY 100
-#define MAX_LINE_LENGTH 1024
+#define MAX_LINE_LENGTH 1024    // Widest wrapped piece drawn
 
-ReleasePage* create_release_page(Release* release) {
+// Console color of each MarkdownStyle
+static const WORD g_markdown_colors[MARKDOWN_STYLE_COUNT] = {
+    CONSOLE_COLOR_NORMAL,
+    CONSOLE_COLOR_HEADER,
+    CONSOLE_COLOR_EMPHASIS,
+    CONSOLE_COLOR_CODE,
+    CONSOLE_COLOR_LINK,
+    CONSOLE_COLOR_BULLET,
+    CONSOLE_COLOR_HEADER
+};
+
+ReleasePage* create_release_page(const ReleaseCollection* releases, int release_id) {
     ReleasePage* page = calloc(1, sizeof(ReleasePage));
     if (!page) return NULL;
     
-    page->release = release;
-    page->scroll_offset = 0;
+    page->releases = releases;
+    page->release_id = release_id;
     
     // Use console dimensions (will be set when displaying)
     page->window_height = 20; // Will be updated when displaying
     page->window_width = 80;  // Will be updated when displaying
     
-    // Initialize lines array
-    page->line_capacity = INITIAL_LINE_CAPACITY;
-    page->lines = calloc(page->line_capacity, sizeof(char*));
-    if (!page->lines) {
-        free(page);
+    // Render the text and index its lines; wrapping waits for the screen
+    if (!parse_release_body(page, get_release(releases, release_id))) {
+        free_release_page(page);
         return NULL;
     }
     
-    // Parse the release body into lines
-    parse_release_body(page, release->body);
-    
     return page;
 }
 
 void free_release_page(ReleasePage* page) {
     if (!page) return;
     
-    if (page->lines) {
-        for (int i = 0; i < page->line_count; i++) {
-            if (page->lines[i]) {
-                free(page->lines[i]);
-            }
-        }
-        free(page->lines);
-    }
-    
+    free_markdown_text(&page->notes);
+    free(page->line_starts);
+    free(page->line_spans);
     free(page);
 }
 
-void add_line_to_page(ReleasePage* page, const char* line) {
-    if (page->line_count >= page->line_capacity) {
-        int new_capacity = page->line_capacity * 2;
-        char** new_lines = realloc(page->lines, new_capacity * sizeof(char*));
-        if (!new_lines) return;
-        
-        page->lines = new_lines;
-        page->line_capacity = new_capacity;
+// Header and notes, rendered into one block of text and styles
+static bool render_release_text(ReleasePage* page, const Release* release) {
+    StringView body = get_release_body(release);
+    if (!init_markdown_text(&page->notes, body.length + 256)) return false;
+    if (!body.data) {
+        return append_markdown_text(&page->notes, NO_RELEASE_NOTES, (int)strlen(NO_RELEASE_NOTES), MARKDOWN_TEXT);
     }
     
-    page->lines[page->line_count] = strdup(line);
-    page->line_count++;
+    // Format created_at
+    struct tm* tm_info = localtime(&release->created_at);
+    char date_str[64] = "";
+    char age[MAX_TIME_DIFF_LENGTH];
+    char header[512];
+    if (tm_info) strftime(date_str, sizeof(date_str), "%Y-%m-%d %H:%M:%S", tm_info);
+    format_release_age(release->created_at, age, sizeof(age));
+    
+    int header_length = snprintf(header, sizeof(header),
+                                 "Owner: %s\nRepo: %s\nTag: %s\nCreated At: %s (%s)\n\n--- Release Notes ---\n\n",
+                                 get_interned_string(release->owner), get_interned_string(release->repo),
+                                 get_interned_string(release->tag), date_str, age);
+    if (header_length >= (int)sizeof(header)) header_length = sizeof(header) - 1;
+    if (!append_markdown_text(&page->notes, header, header_length, MARKDOWN_HEADING)) return false;
+    
+    char* text = unescape_json_alloc(body);
+    if (!text) return false;
+    bool ok = render_markdown(&page->notes, text);
+    free(text);
+    return ok;
 }
 
-void wrap_and_add_line(ReleasePage* page, const char* text) {
-    int text_len = strlen(text);
-    int max_width = page->window_width - 4;  // Leave some margin
+// The body is unescaped and rendered here, when the page is opened,
+// rather than for every release as it is parsed. Besides the rendered
+// text, the only allocations are the two line indexes: nothing is kept
+// per line, and nothing is wrapped yet.
+bool parse_release_body(ReleasePage* page, const Release* release) {
+    if (!render_release_text(page, release)) return false;
     
-    if (text_len <= max_width) {
-        add_line_to_page(page, text);
-        return;
+    const MarkdownText* notes = &page->notes;
+    int count = 1;
+    for (const char* p = notes->text; (p = strchr(p, '\n')) != NULL; p++) {
+        count++;
     }
     
-    // Word wrap long lines
-    char buffer[MAX_LINE_LENGTH];
-    int start = 0;
+    page->line_starts = malloc((count + 1) * sizeof(int));
+    page->line_spans = malloc(count * sizeof(int));
+    if (!page->line_starts || !page->line_spans) return false;
     
-    while (start < text_len) {
-        int end = start + max_width;
-        if (end >= text_len) {
-            strncpy(buffer, text + start, text_len - start);
-            buffer[text_len - start] = '\0';
-            add_line_to_page(page, buffer);
-            break;
-        }
+    int span = 0;
+    for (int line = 0, start = 0; line < count; line++) {
+        while (span + 1 < notes->span_count && notes->spans[span + 1].start <= start) span++;
+        page->line_starts[line] = start;
+        page->line_spans[line] = span;
         
-        // Find last space before max_width
-        int last_space = end;
-        while (last_space > start && text[last_space] != ' ') {
-            last_space--;
-        }
-        
-        if (last_space == start) {
-            // No space found, break at max_width
-            last_space = end;
-        }
-        
-        strncpy(buffer, text + start, last_space - start);
-        buffer[last_space - start] = '\0';
-        add_line_to_page(page, buffer);
-        
-        start = last_space;
-        if (text[start] == ' ') start++;  // Skip the space
+        const char* next = strchr(notes->text + start, '\n');
+        start = next ? (int)(next - notes->text) + 1 : notes->length + 1;
     }
+    page->line_starts[count] = notes->length + 1;   // As if a newline followed the last line
+    page->line_count = count;
+    return true;
+}
+
+// One line of the text, without its line break
+static const char* get_line(const ReleasePage* page, int line, int* length) {
+    const char* text = page->notes.text + page->line_starts[line];
+    
+    *length = page->line_starts[line + 1] - 1 - page->line_starts[line];
+    if (*length > 0 && text[*length - 1] == '\r') (*length)--;
+    return text;
+}
+
+// Width lines are wrapped to, as of the last draw
+static int get_wrap_width(const ReleasePage* page) {
+    int width = page->window_width - 4;  // Leave some margin
+    
+    if (width < 1) width = 1;
+    if (width > MAX_LINE_LENGTH - 1) width = MAX_LINE_LENGTH - 1;
+    return width;
 }
 
-void parse_release_body(ReleasePage* page, const char* body) {
-    if (!body) {
-        add_line_to_page(page, "No release notes available.");
-        return;
+// Wrap a line one piece at a time: the piece from start ends at *end, at
+// most width bytes on, after the last word that fits. Returns where the
+// next piece starts, or length when this one was the last.
+static int next_piece(const char* line, int length, int start, int width, int* end) {
+    int limit = start + width;
+    if (limit >= length) {
+        *end = length;
+        return length;
+    }
+    
+    // Find last space before width
+    int space = limit;
+    while (space > start && line[space] != ' ') {
+        space--;
+    }
+    if (space > start) {
+        *end = space;
+        return space + 1;  // Skip the space
     }
     
-    // Add header information
-    char header[256];
-    snprintf(header, sizeof(header), "Owner: %s", page->release->owner);
-    add_line_to_page(page, header);
+    // No space found: break at width, though not inside a UTF-8 sequence
+    while (limit > start + 1 && ((unsigned char)line[limit] & 0xC0) == 0x80) {
+        limit--;
+    }
+    *end = limit;
+    return limit;
+}
+
+static int count_pieces(const ReleasePage* page, int line, int width) {
+    int length;
+    const char* text = get_line(page, line, &length);
+    int count = 1;
+    int end;
     
-    snprintf(header, sizeof(header), "Repo: %s", page->release->repo);
-    add_line_to_page(page, header);
+    for (int start = 0; (start = next_piece(text, length, start, width, &end)) < length; ) {
+        count++;
+    }
+    return count;
+}
+
+// Copy one wrapped piece of a line to the screen, one run per style in it
+static void draw_piece(ReleasePage* page, UIState* state, int y, int line, int start, int end) {
+    const MarkdownText* notes = &page->notes;
+    int offset = page->line_starts[line];
+    int span = page->line_spans[line];
+    char run[MAX_LINE_LENGTH];
+    int x = 2;
     
-    snprintf(header, sizeof(header), "Tag: %s", page->release->tag_name);
-    add_line_to_page(page, header);
+    start += offset;
+    end += offset;
+    while (span + 1 < notes->span_count && notes->spans[span + 1].start <= start) span++;
     
-    // Format created_at
-    struct tm* tm_info = localtime(&page->release->created_at);
-    char date_str[64];
-    strftime(date_str, sizeof(date_str), "%Y-%m-%d %H:%M:%S", tm_info);
-    snprintf(header, sizeof(header), "Created At: %s (%s)", 
-             date_str, page->release->time_difference);
-    add_line_to_page(page, header);
-    
-    add_line_to_page(page, "");
-    add_line_to_page(page, "--- Release Notes ---");
-    add_line_to_page(page, "");
-    
-    // Parse body line by line
-    char* body_copy = strdup(body);
-    char* line = strtok(body_copy, "\n");
-    
-    while (line != NULL) {
-        // Handle empty lines
-        if (strlen(line) == 0) {
-            add_line_to_page(page, "");
-        } else {
-            wrap_and_add_line(page, line);
+    while (start < end) {
+        int run_end = end;
+        if (span + 1 < notes->span_count && notes->spans[span + 1].start < run_end) {
+            run_end = notes->spans[span + 1].start;
+        }
+        
+        memcpy(run, notes->text + start, run_end - start);
+        run[run_end - start] = '\0';
+        WORD color = (span < notes->span_count) ? g_markdown_colors[notes->spans[span].style] : CONSOLE_COLOR_NORMAL;
+        print_colored_at(state, x, y, run, color);
+        
+        // Cells, not bytes: bullets and names may be UTF-8
+        for (const char* p = run; *p; p++) {
+            if (((unsigned char)*p & 0xC0) != 0x80) x++;
         }
-        line = strtok(NULL, "\n");
+        start = run_end;
+        span++;
     }
-    
-    free(body_copy);
 }
 
+// Wraps just the lines that are on screen, at the current console width,
+// and copies out their styles as rendered when the page opened
 void draw_release_content(ReleasePage* page, UIState* state) {
     // Update window dimensions from console state
     page->window_width = state->console_width - 4;
     page->window_height = state->console_height - 6;
     
+    int width = get_wrap_width(page);
     int visible_lines = page->window_height - 2;  // Account for borders
-    int end_line = page->scroll_offset + visible_lines;
-    if (end_line > page->line_count) {
-        end_line = page->line_count;
-    }
+    
+    // A narrower console may have fewer pieces to the top line than before
+    int top_pieces = count_pieces(page, page->top_line, width);
+    if (page->top_piece >= top_pieces) page->top_piece = top_pieces - 1;
     
     int y = 4;  // Start below header
-    for (int i = page->scroll_offset; i < end_line; i++) {
-        // Simple color coding for headers
-        if (strncmp(page->lines[i], "Owner:", 6) == 0 ||
-            strncmp(page->lines[i], "Repo:", 5) == 0 ||
-            strncmp(page->lines[i], "Tag:", 4) == 0 ||
-            strncmp(page->lines[i], "Created At:", 11) == 0) {
-            print_colored_at(state, 2, y, page->lines[i], CONSOLE_COLOR_HEADER);
-        } else if (strncmp(page->lines[i], "---", 3) == 0) {
-            print_colored_at(state, 2, y, page->lines[i], CONSOLE_COLOR_HEADER);
-        } else {
-            print_at(state, 2, y, page->lines[i]);
+    int skip = page->top_piece;
+    bool more = false;
+    for (int line = page->top_line; line < page->line_count && !more; line++) {
+        int length;
+        const char* text = get_line(page, line, &length);
+        
+        int start = 0;
+        for (;;) {
+            int end;
+            int next = next_piece(text, length, start, width, &end);
+            
+            if (skip > 0) {
+                skip--;
+            } else if (y - 4 == visible_lines) {
+                more = true;
+                break;
+            } else {
+                draw_piece(page, state, y++, line, start, end);
+            }
+            if (next >= length) break;
+            start = next;
         }
-        y++;
     }
+    page->at_end = !more;
     
     // Draw scroll indicators
-    if (page->scroll_offset > 0) {
+    if (page->top_line > 0 || page->top_piece > 0) {
         print_at(state, page->window_width / 2 - 4, 3, " [MORE] ");
     }
-    if (end_line < page->line_count) {
+    if (more) {
         print_at(state, page->window_width / 2 - 4, state->console_height - 3, " [MORE] ");
     }
 }
 
+// One wrapped piece at a time; down stops once the end is on screen
 void scroll_release_page(ReleasePage* page, int direction) {
-    int visible_lines = page->window_height - 2;
+    int width = get_wrap_width(page);
     
     if (direction > 0) {  // Scroll down
-        if (page->scroll_offset + visible_lines < page->line_count) {
-            page->scroll_offset++;
+        if (page->at_end) return;
+        if (page->top_piece + 1 < count_pieces(page, page->top_line, width)) {
+            page->top_piece++;
+        } else if (page->top_line + 1 < page->line_count) {
+            page->top_line++;
+            page->top_piece = 0;
         }
     } else {  // Scroll up
-        if (page->scroll_offset > 0) {
-            page->scroll_offset--;
+        if (page->top_piece > 0) {
+            page->top_piece--;
+        } else if (page->top_line > 0) {
+            page->top_line--;
+            page->top_piece = count_pieces(page, page->top_line, width) - 1;
+        }
+    }
+}
+
+// Fill the window from the last line upwards, wrapping only those lines
+static void scroll_release_page_to_end(ReleasePage* page) {
+    int width = get_wrap_width(page);
+    int rows = page->window_height - 2;
+    
+    for (int line = page->line_count - 1; line >= 0 && rows > 0; line--) {
+        int pieces = count_pieces(page, line, width);
+        if (pieces >= rows) {
+            page->top_line = line;
+            page->top_piece = pieces - rows;
+            return;
         }
+        rows -= pieces;
     }
+    page->top_line = 0;
+    page->top_piece = 0;
 }
 
 void display_release_page(ReleasePage* page, UIState* state) {
@@ -207,29 +295,39 @@ void display_release_page(ReleasePage* page, UIState* state) {
 }
 
 void handle_release_input(ReleasePage* page, UIState* state, int ch) {
+    // Arrows and Home/End arrive as the prefix and a scan code; the scan
+    // codes alone are letters ('G' is also KEY_HOME)
+    if (ch == 0 || ch == KEY_EXTENDED) {
+        switch (getch()) {
+            case KEY_DOWN: ch = 'j'; break;
+            case KEY_UP:   ch = 'k'; break;
+            case KEY_HOME: ch = 'g'; break;
+            case KEY_END:  ch = 'G'; break;
+            default: return;
+        }
+    }
+    
     switch (ch) {
         case 'j':
-        case KEY_DOWN: // Down arrow (Windows)
             scroll_release_page(page, 1);
             display_release_page(page, state);
             break;
             
         case 'k':
-        case KEY_UP: // Up arrow (Windows)
             scroll_release_page(page, -1);
             display_release_page(page, state);
             break;
             
         case 'G':
             // Go to bottom
-            page->scroll_offset = page->line_count - (page->window_height - 2);
-            if (page->scroll_offset < 0) page->scroll_offset = 0;
+            scroll_release_page_to_end(page);
             display_release_page(page, state);
             break;
             
         case 'g':
             // Go to top
-            page->scroll_offset = 0;
+            page->top_line = 0;
+            page->top_piece = 0;
             display_release_page(page, state);
             break;
             
@@ -1,27 +1,38 @@
 #ifndef RELEASE_PAGE_H
 #define RELEASE_PAGE_H
 
-#include <Windows.h>
 #include "requests.h"
 #include "ui.h"
+#include "markdown.h"
 
+// Holds its release by record number rather than by pointer, so the
+// page stays valid however the table is reordered while it is open.
+// The notes are rendered from markdown once, when the page opens, into
+// one block of text and its style spans, with an index of where each line
+// starts; lines are wrapped only as they are drawn, at the width of the
+// console at that moment. The scroll position is a line and a piece of
+// it, so it survives a change of width.
 typedef struct {
-    Release* release;
-    char** lines;  // Array of text lines
+    const ReleaseCollection* releases;
+    int release_id;
+    MarkdownText notes; // Header lines, then the rendered notes
+    int* line_starts;   // Offset of each line in notes.text
+    int* line_spans;    // Span in effect where each line starts
     int line_count;
-    int line_capacity;
-    int scroll_offset;
+    int top_line;       // First line on screen...
+    int top_piece;      // ...from this wrapped piece of it on
+    bool at_end;        // The last draw reached the end of the text
     int window_height;
     int window_width;
 } ReleasePage;
 
 // Function declarations
-ReleasePage* create_release_page(Release* release);
+ReleasePage* create_release_page(const ReleaseCollection* releases, int release_id);
 void free_release_page(ReleasePage* page);
 void display_release_page(ReleasePage* page, struct UIState* state);
 void handle_release_input(ReleasePage* page, struct UIState* state, int ch);
 void scroll_release_page(ReleasePage* page, int direction);
-void parse_release_body(ReleasePage* page, const char* body);
+bool parse_release_body(ReleasePage* page, const Release* release);
 void draw_release_content(ReleasePage* page, struct UIState* state);
 
 #endif // RELEASE_PAGE_H
\ No newline at end of file
@@ -0,0 +1,307 @@
+#include "release_parser.h"
+#include "json_scan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RELEASE_FIELD_TAG        0x01
+#define RELEASE_FIELD_URL        0x02
+#define RELEASE_FIELD_BODY       0x04
+#define RELEASE_FIELD_PRERELEASE 0x08
+#define RELEASE_FIELD_CREATED_AT 0x10
+#define RELEASE_FIELD_ASSETS     0x20
+#define RELEASE_FIELDS_ALL       0x3f
+
+#define TEXT_INITIAL_CAPACITY 1024
+
+// Top-level keys the parser keeps; everything else is skipped unbuffered
+static const struct {
+    const char* key;
+    unsigned int bit;
+    CaptureTarget target;
+} g_release_fields[] = {
+    { "tag_name",   RELEASE_FIELD_TAG,        CAPTURE_TAG },
+    { "html_url",   RELEASE_FIELD_URL,        CAPTURE_URL },
+    { "body",       RELEASE_FIELD_BODY,       CAPTURE_BODY },
+    { "prerelease", RELEASE_FIELD_PRERELEASE, CAPTURE_NONE },
+    { "created_at", RELEASE_FIELD_CREATED_AT, CAPTURE_CREATED_AT },
+    { "assets",     RELEASE_FIELD_ASSETS,     CAPTURE_NONE },
+};
+
+void init_release_parser(ReleaseParser* parser, const RepoInfo* repo) {
+    memset(parser, 0, sizeof(ReleaseParser));
+    parser->release.owner = repo->owner_id;
+    parser->release.repo = repo->repo_id;
+    parser->release.tag = -1;
+    parser->text_len = sizeof(ReleaseDetails);  // Strings follow the details header
+}
+
+void free_release_parser(ReleaseParser* parser) {
+    free(parser->text);
+    parser->text = NULL;
+}
+
+bool release_parser_done(const ReleaseParser* parser) {
+    return parser->failed || parser->seen == RELEASE_FIELDS_ALL;
+}
+
+// Decide what to do with a value given its first character. Returns where
+// the characters of a string value should be captured.
+static CaptureTarget begin_value(ReleaseParser* parser, char first) {
+    if (parser->depth == 1 && parser->stack[0] == '{') {
+        for (size_t i = 0; i < sizeof(g_release_fields) / sizeof(g_release_fields[0]); i++) {
+            if (strcmp(parser->key, g_release_fields[i].key) != 0) continue;
+
+            unsigned int bit = g_release_fields[i].bit;
+            if (bit == RELEASE_FIELD_ASSETS && first == '[') {
+                parser->assets_depth = parser->depth + 1;  // Seen once the array closes
+            } else if (bit == RELEASE_FIELD_PRERELEASE) {
+                if (first == 't') parser->release.flags |= RELEASE_PRERELEASE;
+                parser->seen |= bit;
+            } else if (first == '"' && g_release_fields[i].target != CAPTURE_NONE) {
+                return g_release_fields[i].target;
+            } else {
+                parser->seen |= bit;  // null or an unexpected type: keep the default
+            }
+            return CAPTURE_NONE;
+        }
+    } else if (parser->assets_depth && parser->depth == parser->assets_depth + 1 &&
+               parser->stack[parser->depth - 1] == '{' && first == '"' &&
+               strcmp(parser->key, "name") == 0) {
+        return CAPTURE_ASSET_NAME;
+    }
+    return CAPTURE_NONE;
+}
+
+static void begin_string(ReleaseParser* parser, CaptureTarget target) {
+    parser->target = target;
+    parser->capture_len = 0;
+
+    switch (target) {
+        case CAPTURE_KEY:
+            parser->capture = parser->key;
+            parser->capture_size = sizeof(parser->key);
+            break;
+        case CAPTURE_TAG:
+            parser->capture = parser->tag;
+            parser->capture_size = sizeof(parser->tag);
+            break;
+        case CAPTURE_CREATED_AT:
+            parser->capture = parser->created_at;
+            parser->capture_size = sizeof(parser->created_at);
+            break;
+        case CAPTURE_ASSET_NAME:
+            begin_asset_scan(&parser->asset_scan);
+            parser->capture = NULL;
+            parser->capture_size = 0;
+            break;
+        case CAPTURE_URL:
+        case CAPTURE_BODY:
+            // A repeated key simply starts a new copy further along
+            parser->field_offset[target] = parser->text_len;
+            parser->capture = NULL;
+            parser->capture_size = 0;
+            break;
+        case CAPTURE_NONE:
+            parser->capture = NULL;
+            parser->capture_size = 0;
+            break;
+    }
+    parser->lex = LEX_STRING;
+}
+
+static void append_text(ReleaseParser* parser, const char* data, size_t len) {
+    if (parser->text_len + len + 1 > parser->text_capacity) {
+        size_t new_capacity = parser->text_capacity ? parser->text_capacity : TEXT_INITIAL_CAPACITY;
+        while (new_capacity < parser->text_len + len + 1) new_capacity *= 2;
+
+        char* new_text = realloc(parser->text, new_capacity);
+        if (!new_text) {
+            parser->failed = true;
+            return;
+        }
+        parser->text = new_text;
+        parser->text_capacity = new_capacity;
+    }
+    memcpy(parser->text + parser->text_len, data, len);
+    parser->text_len += len;
+}
+
+// Strings are kept JSON-escaped, exactly as they appear on the wire
+static void append_string(ReleaseParser* parser, const char* data, size_t len) {
+    if (parser->target < RELEASE_PARSER_TEXT_FIELDS) {
+        append_text(parser, data, len);
+    } else if (parser->target == CAPTURE_ASSET_NAME) {
+        feed_asset_scan(&parser->asset_scan, data, len);
+    } else if (parser->capture) {
+        // Fixed-size fields are truncated like the strncpy they replace
+        size_t room = parser->capture_size - 1 - parser->capture_len;
+        if (len > room) len = room;
+        memcpy(parser->capture + parser->capture_len, data, len);
+        parser->capture_len += len;
+    }
+}
+
+static void end_string(ReleaseParser* parser) {
+    if (parser->capture) parser->capture[parser->capture_len] = '\0';
+
+    switch (parser->target) {
+        case CAPTURE_KEY:
+            parser->expect_key = false;
+            break;
+        case CAPTURE_URL:
+        case CAPTURE_BODY:
+            parser->field_length[parser->target] = parser->text_len - parser->field_offset[parser->target];
+            append_text(parser, "", 1);  // NUL-terminate the field in place
+            parser->captured |= 1u << parser->target;
+            parser->seen |= (parser->target == CAPTURE_URL) ? RELEASE_FIELD_URL : RELEASE_FIELD_BODY;
+            break;
+        case CAPTURE_TAG:
+            parser->seen |= RELEASE_FIELD_TAG;
+            break;
+        case CAPTURE_CREATED_AT:
+            parser->seen |= RELEASE_FIELD_CREATED_AT;
+            break;
+        case CAPTURE_ASSET_NAME:
+            parser->release.platforms |= parser->asset_scan.mask;
+            break;
+        case CAPTURE_NONE:
+            break;
+    }
+
+    parser->target = CAPTURE_NONE;
+    parser->capture = NULL;
+    parser->lex = LEX_SPACE;
+}
+
+static void open_container(ReleaseParser* parser, char c) {
+    if (parser->depth >= RELEASE_PARSER_MAX_DEPTH) {
+        parser->failed = true;
+        return;
+    }
+    parser->stack[parser->depth++] = c;
+    parser->expect_key = (c == '{');
+}
+
+static void close_container(ReleaseParser* parser, char c) {
+    char open = (c == '}') ? '{' : '[';
+    if (parser->depth == 0 || parser->stack[parser->depth - 1] != open) {
+        parser->failed = true;
+        return;
+    }
+    parser->depth--;
+    parser->expect_key = false;
+
+    if (parser->assets_depth && parser->depth < parser->assets_depth) {
+        parser->seen |= RELEASE_FIELD_ASSETS;
+        parser->assets_depth = 0;
+    }
+    // The whole document has been read: nothing more can turn up
+    if (parser->depth == 0) parser->seen = RELEASE_FIELDS_ALL;
+}
+
+bool feed_release_parser(ReleaseParser* parser, const char* data, size_t len) {
+    const char* p = data;
+    const char* end = data + len;
+
+    while (p < end && !release_parser_done(parser)) {
+        switch (parser->lex) {
+            case LEX_STRING: {
+                // Copy everything up to the next quote or escape in one go
+                const char* span = p;
+                p += json_scan_string(p, end - p);
+                append_string(parser, span, p - span);
+                if (p == end) break;
+
+                if (*p == '"') {
+                    end_string(parser);
+                } else {
+                    append_string(parser, p, 1);
+                    parser->lex = LEX_STRING_ESCAPE;
+                }
+                p++;
+                break;
+            }
+
+            case LEX_STRING_ESCAPE:
+                append_string(parser, p, 1);
+                parser->lex = LEX_STRING;
+                p++;
+                break;
+
+            case LEX_LITERAL:
+                if (*p == ',' || *p == '}' || *p == ']' ||
+                    *p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+                    parser->lex = LEX_SPACE;  // Reprocess the delimiter
+                } else {
+                    p++;
+                }
+                break;
+
+            case LEX_SPACE: {
+                char c = *p++;
+                switch (c) {
+                    case ' ': case '\t': case '\r': case '\n': case ':':
+                        break;
+                    case '{':
+                    case '[':
+                        begin_value(parser, c);
+                        open_container(parser, c);
+                        break;
+                    case '}':
+                    case ']':
+                        close_container(parser, c);
+                        break;
+                    case ',':
+                        parser->expect_key = (parser->depth > 0 && parser->stack[parser->depth - 1] == '{');
+                        break;
+                    case '"':
+                        if (parser->expect_key) {
+                            begin_string(parser, CAPTURE_KEY);
+                        } else {
+                            begin_string(parser, begin_value(parser, c));
+                        }
+                        break;
+                    default:
+                        begin_value(parser, c);
+                        parser->lex = LEX_LITERAL;
+                        break;
+                }
+                break;
+            }
+        }
+    }
+
+    return !parser->failed;
+}
+
+// View of a captured field, or fallback when it was missing or null
+static StringView field_view(const ReleaseParser* parser, CaptureTarget field, const char* fallback) {
+    if (!(parser->captured & (1u << field)) || !parser->text) return make_string_view(fallback);
+
+    StringView view = { parser->text + parser->field_offset[field], (int)parser->field_length[field] };
+    return view;
+}
+
+// Hand the parsed release to the caller. The parser's text buffer was
+// laid out as a ReleaseDetails block from the start, so it becomes the
+// release's details as is and the fields are views into it.
+void finish_release_parser(ReleaseParser* parser, Release* release) {
+    *release = parser->release;
+
+    release->tag = parser->tag[0] ? intern_json_string(make_string_view(parser->tag)) : -1;
+
+    if (!parser->text) {
+        set_release_text(release, make_string_view(""), make_string_view(NO_RELEASE_NOTES));
+    } else {
+        ReleaseDetails* details = (ReleaseDetails*)parser->text;
+        details->url = field_view(parser, CAPTURE_URL, "");
+        details->body = field_view(parser, CAPTURE_BODY, NO_RELEASE_NOTES);
+        release->details = details;
+        parser->text = NULL;
+    }
+
+    if (parser->created_at[0]) {
+        release->created_at = parse_timestamp(parser->created_at);
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef RELEASE_PARSER_H
+#define RELEASE_PARSER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "requests.h"
+#include "asset_classifier.h"
+
+#define RELEASE_PARSER_MAX_DEPTH 64
+#define RELEASE_PARSER_KEY_LENGTH 32
+#define RELEASE_PARSER_TIMESTAMP_LENGTH 32
+
+typedef enum {
+    LEX_SPACE,          // Between tokens
+    LEX_STRING,
+    LEX_STRING_ESCAPE,
+    LEX_LITERAL         // Number, true, false or null
+} LexState;
+
+// Where the characters of the current string go. URL and body are
+// appended to the release's text buffer; the rest use small fixed buffers.
+typedef enum {
+    CAPTURE_URL,
+    CAPTURE_BODY,
+    CAPTURE_NONE,
+    CAPTURE_KEY,
+    CAPTURE_TAG,
+    CAPTURE_CREATED_AT,
+    CAPTURE_ASSET_NAME
+} CaptureTarget;
+
+#define RELEASE_PARSER_TEXT_FIELDS 2    // CAPTURE_URL .. CAPTURE_BODY
+
+// Push parser for one /releases/latest object. Chunks are fed as they
+// arrive; only the fields a Release needs are kept, and once all of them
+// are seen the rest of the document is ignored.
+typedef struct {
+    Release release;
+    LexState lex;
+    char stack[RELEASE_PARSER_MAX_DEPTH];   // '{' or '[' per open container
+    int depth;
+    bool expect_key;
+    int assets_depth;                       // Depth of the assets array, 0 outside it
+    unsigned int seen;                      // RELEASE_FIELD_* bits
+    bool failed;
+
+    CaptureTarget target;
+    char* capture;                          // Fixed buffer for the current string
+    size_t capture_len;
+    size_t capture_size;
+
+    char key[RELEASE_PARSER_KEY_LENGTH];
+    char tag[MAX_TAG_LENGTH];               // Interned when the parser finishes
+    AssetScan asset_scan;                   // Asset names are classified as they arrive
+    char created_at[RELEASE_PARSER_TIMESTAMP_LENGTH];
+
+    char* text;                             // Becomes Release.details
+    size_t text_len;
+    size_t text_capacity;
+    size_t field_offset[RELEASE_PARSER_TEXT_FIELDS];
+    size_t field_length[RELEASE_PARSER_TEXT_FIELDS];
+    unsigned int captured;                  // Bit per text field read from a string
+} ReleaseParser;
+
+// Function declarations
+void init_release_parser(ReleaseParser* parser, const RepoInfo* repo);
+bool feed_release_parser(ReleaseParser* parser, const char* data, size_t len);
+bool release_parser_done(const ReleaseParser* parser);
+void finish_release_parser(ReleaseParser* parser, Release* release);
+void free_release_parser(ReleaseParser* parser);
+
+#endif // RELEASE_PARSER_H
@@ -0,0 +1,160 @@
+#include "release_queue.h"
+#include "release_sort.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#endif
+
+typedef struct ReleaseNode {
+    Release release;
+    struct ReleaseNode* volatile next;
+} ReleaseNode;
+
+// Dmitry Vyukov's intrusive MPSC queue. Producers swap themselves into
+// head with one atomic exchange and then link the previous node to
+// themselves; the consumer walks from tail. The stub node keeps the
+// list non-empty, so neither side ever needs a lock.
+struct ReleaseQueue {
+    ReleaseNode* volatile head;     // Most recently published node
+    ReleaseNode* tail;              // Next node to drain; consumer only
+    ReleaseNode stub;
+    WaitHandle signal;              // Set by publishers, reset by the consumer
+};
+
+ReleaseQueue* create_release_queue(void) {
+    ReleaseQueue* queue = calloc(1, sizeof(ReleaseQueue));
+    if (!queue) return NULL;
+
+#ifdef _WIN32
+    queue->signal = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (!queue->signal) {
+#else
+    queue->signal = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (queue->signal < 0) {
+#endif
+        fprintf(stderr, "Error: Failed to create the release queue signal\n");
+        free(queue);
+        return NULL;
+    }
+
+    queue->head = &queue->stub;
+    queue->tail = &queue->stub;
+    return queue;
+}
+
+static void set_signal(ReleaseQueue* queue) {
+#ifdef _WIN32
+    SetEvent(queue->signal);
+#else
+    // Only fails when the counter is saturated, i.e. already signalled
+    uint64_t one = 1;
+    ssize_t written = write(queue->signal, &one, sizeof(one));
+    (void)written;
+#endif
+}
+
+static void reset_signal(ReleaseQueue* queue) {
+#ifdef _WIN32
+    ResetEvent(queue->signal);
+#else
+    uint64_t count;
+    ssize_t got = read(queue->signal, &count, sizeof(count));
+    (void)got;
+#endif
+}
+
+static void push_node(ReleaseQueue* queue, ReleaseNode* node) {
+    node->next = NULL;
+    ReleaseNode* prev = (ReleaseNode*)InterlockedExchangePointer((void* volatile*)&queue->head, node);
+    // Until this store lands the consumer sees the list end at prev
+    WritePointerRelease((void* volatile*)&prev->next, node);
+}
+
+static ReleaseNode* pop_node(ReleaseQueue* queue) {
+    ReleaseNode* tail = queue->tail;
+    ReleaseNode* next = (ReleaseNode*)ReadPointerAcquire((void* volatile*)&tail->next);
+
+    if (tail == &queue->stub) {
+        if (!next) return NULL;
+        queue->tail = next;
+        tail = next;
+        next = (ReleaseNode*)ReadPointerAcquire((void* volatile*)&tail->next);
+    }
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+
+    // tail looks like the last node. If a producer has already swapped
+    // itself in behind it, its link is not visible yet: try again later.
+    if (tail != (ReleaseNode*)ReadPointerAcquire((void* volatile*)&queue->head)) return NULL;
+
+    // Put the stub back behind tail so tail itself can be handed out
+    push_node(queue, &queue->stub);
+    next = (ReleaseNode*)ReadPointerAcquire((void* volatile*)&tail->next);
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+// Takes over the release's text on success; the caller frees it otherwise
+bool publish_release(ReleaseQueue* queue, const Release* release) {
+    ReleaseNode* node = malloc(sizeof(ReleaseNode));
+    if (!node) return false;
+
+    node->release = *release;
+    push_node(queue, node);
+    // After the push, so a consumer woken by it always finds the node
+    set_signal(queue);
+    return true;
+}
+
+// Move everything published so far into collection and merge it into the
+// table order in one go. Returns how many releases were added. UI thread only.
+int drain_release_queue(ReleaseQueue* queue, ReleaseCollection* collection) {
+    int added = 0;
+    ReleaseNode* node;
+
+    // Before popping: whatever is published from here on signals again
+    reset_signal(queue);
+    while ((node = pop_node(queue)) != NULL) {
+        if (add_release_to_collection(collection, &node->release)) {
+            added++;
+        } else {
+            free_release_text(&node->release);
+        }
+        free(node);
+    }
+    if (added > 0 && !sync_release_order(collection)) {
+        fprintf(stderr, "Warning: Failed to sort new releases into the table\n");
+    }
+    return added;
+}
+
+// Signalled while releases wait to be drained
+WaitHandle get_release_queue_wait_handle(const ReleaseQueue* queue) {
+    return queue->signal;
+}
+
+// Producers must have stopped before the queue is freed
+void free_release_queue(ReleaseQueue* queue) {
+    if (!queue) return;
+
+    ReleaseNode* node;
+    while ((node = pop_node(queue)) != NULL) {
+        free_release_text(&node->release);
+        free(node);
+    }
+#ifdef _WIN32
+    CloseHandle(queue->signal);
+#else
+    close(queue->signal);
+#endif
+    free(queue);
+}
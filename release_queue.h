@@ -0,0 +1,21 @@
+#ifndef RELEASE_QUEUE_H
+#define RELEASE_QUEUE_H
+
+#include <stdbool.h>
+#include "platform.h"
+#include "requests.h"
+
+// Finished releases on their way from the fetch threads to the UI thread.
+// Any number of threads may publish; only the UI thread drains, into a
+// ReleaseCollection that nothing else touches. Every publish signals the
+// queue's wait handle and every drain resets it, so the UI thread can sleep
+// until something arrives.
+
+// Function declarations
+ReleaseQueue* create_release_queue(void);
+void free_release_queue(ReleaseQueue* queue);
+bool publish_release(ReleaseQueue* queue, const Release* release);
+int drain_release_queue(ReleaseQueue* queue, ReleaseCollection* collection);
+WaitHandle get_release_queue_wait_handle(const ReleaseQueue* queue);
+
+#endif // RELEASE_QUEUE_H
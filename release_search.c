@@ -0,0 +1,364 @@
+#include "release_search.h"
+#include "string_table.h"
+#include "arena.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEARCH_TEXT_LENGTH (2 * MAX_REPO_NAME_LENGTH + MAX_TAG_LENGTH + 2)
+#define POSTING_INITIAL_CAPACITY 4
+#define SEARCH_TEXT_CHUNK_SIZE (64 * 1024)
+
+typedef struct {
+    int* ids;               // Ascending record numbers
+    int count;
+    int capacity;
+} PostingList;
+
+typedef struct {
+    const char* data;       // NULL if the record could not be indexed
+    int length;
+} SearchText;
+
+// Open-addressing map from packed trigram to posting list
+struct SearchIndex {
+    unsigned int* keys;     // 0 marks an empty bucket; text never holds a NUL
+    PostingList* lists;
+    int bucket_bits;
+    int used;
+
+    // Each record's search text, to confirm candidates without rebuilding it
+    Arena* text_arena;
+    SearchText* texts;      // By record number
+    int text_capacity;
+
+    // Scratch for filter_releases, one slot per record. scores is all zero
+    // between searches, so a search only touches the records it scores.
+    int* scores;
+    int* touched;
+    int scratch_capacity;
+};
+
+// A record that passed the filter, with what it is ranked by
+typedef struct {
+    int id;
+    int score;              // Query trigrams shared; above all of them for an exact match
+    int row;                // Row in the table order shown
+} SearchMatch;
+
+static char fold_char(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+static unsigned int pack_trigram(const char* text) {
+    return ((unsigned int)(unsigned char)text[0] << 16) |
+           ((unsigned int)(unsigned char)text[1] << 8) |
+           (unsigned int)(unsigned char)text[2];
+}
+
+// What a record is searched by: "owner/repo tag", case-folded
+static int make_search_text(const Release* release, char* text, size_t size) {
+    int len = snprintf(text, size, "%s/%s %s", get_interned_string(release->owner),
+                       get_interned_string(release->repo), get_interned_string(release->tag));
+    if (len < 0) len = 0;
+    if ((size_t)len >= size) len = (int)size - 1;
+
+    for (int i = 0; i < len; i++) text[i] = fold_char(text[i]);
+    return len;
+}
+
+static int find_bucket(const unsigned int* keys, int bits, unsigned int key) {
+    unsigned int mask = (1u << bits) - 1;
+    unsigned int bucket = (key * 2654435761u) >> (32 - bits);  // Fibonacci hashing
+
+    while (keys[bucket] != 0 && keys[bucket] != key) bucket = (bucket + 1) & mask;
+    return (int)bucket;
+}
+
+// Move every list into a table of 2^bits buckets
+static bool resize_buckets(SearchIndex* index, int bits) {
+    unsigned int* keys = calloc((size_t)1 << bits, sizeof(unsigned int));
+    PostingList* lists = calloc((size_t)1 << bits, sizeof(PostingList));
+    if (!keys || !lists) {
+        free(keys);
+        free(lists);
+        return false;
+    }
+
+    for (int i = 0; index->keys && i < (1 << index->bucket_bits); i++) {
+        if (index->keys[i] == 0) continue;
+        int bucket = find_bucket(keys, bits, index->keys[i]);
+        keys[bucket] = index->keys[i];
+        lists[bucket] = index->lists[i];
+    }
+
+    free(index->keys);
+    free(index->lists);
+    index->keys = keys;
+    index->lists = lists;
+    index->bucket_bits = bits;
+    return true;
+}
+
+SearchIndex* create_search_index(void) {
+    SearchIndex* index = calloc(1, sizeof(SearchIndex));
+    if (!index) return NULL;
+
+    int bits = 0;
+    while ((1 << bits) < SEARCH_INITIAL_BUCKETS) bits++;
+    index->text_arena = create_arena(SEARCH_TEXT_CHUNK_SIZE);
+    if (!index->text_arena || !resize_buckets(index, bits)) {
+        free_arena(index->text_arena);
+        free(index);
+        return NULL;
+    }
+    return index;
+}
+
+void free_search_index(SearchIndex* index) {
+    if (!index) return;
+
+    for (int i = 0; i < (1 << index->bucket_bits); i++) {
+        free(index->lists[i].ids);
+    }
+    free(index->keys);
+    free(index->lists);
+    free_arena(index->text_arena);
+    free(index->texts);
+    free(index->scores);
+    free(index->touched);
+    free(index);
+}
+
+static PostingList* find_list(const SearchIndex* index, unsigned int key) {
+    int bucket = find_bucket(index->keys, index->bucket_bits, key);
+    return index->keys[bucket] ? &index->lists[bucket] : NULL;
+}
+
+static PostingList* find_or_add_list(SearchIndex* index, unsigned int key) {
+    // Double the table once it is half full
+    if (index->used * 2 >= (1 << index->bucket_bits) &&
+        !resize_buckets(index, index->bucket_bits + 1)) {
+        return NULL;
+    }
+
+    int bucket = find_bucket(index->keys, index->bucket_bits, key);
+    if (index->keys[bucket] == 0) {
+        index->keys[bucket] = key;
+        index->used++;
+    }
+    return &index->lists[bucket];
+}
+
+// Add a record's trigrams. Records must be indexed in the order they were
+// numbered, which keeps every posting list sorted without any sorting.
+bool index_release(SearchIndex* index, int id, const Release* release) {
+    char text[SEARCH_TEXT_LENGTH];
+    int len = make_search_text(release, text, sizeof(text));
+
+    if (id >= index->text_capacity) {
+        int new_capacity = index->text_capacity ? index->text_capacity * 2 : 256;
+        while (new_capacity <= id) new_capacity *= 2;
+        SearchText* new_texts = realloc(index->texts, new_capacity * sizeof(SearchText));
+        if (!new_texts) return false;
+        memset(new_texts + index->text_capacity, 0,
+               (new_capacity - index->text_capacity) * sizeof(SearchText));
+        index->texts = new_texts;
+        index->text_capacity = new_capacity;
+    }
+
+    char* copy = arena_alloc(index->text_arena, len + 1);
+    if (!copy) return false;
+    memcpy(copy, text, len + 1);
+    index->texts[id].data = copy;
+    index->texts[id].length = len;
+
+    for (int i = 0; i + 3 <= len; i++) {
+        PostingList* list = find_or_add_list(index, pack_trigram(text + i));
+        if (!list) return false;
+        if (list->count > 0 && list->ids[list->count - 1] == id) continue;  // Repeated in this record
+
+        if (list->count >= list->capacity) {
+            int new_capacity = list->capacity ? list->capacity * 2 : POSTING_INITIAL_CAPACITY;
+            int* new_ids = realloc(list->ids, new_capacity * sizeof(int));
+            if (!new_ids) return false;
+            list->ids = new_ids;
+            list->capacity = new_capacity;
+        }
+        list->ids[list->count++] = id;
+    }
+    return true;
+}
+
+bool add_to_release_view(ReleaseView* view, int id) {
+    if (view->count >= view->capacity) {
+        int new_capacity = view->capacity ? view->capacity * 2 : 64;
+        int* new_ids = realloc(view->ids, new_capacity * sizeof(int));
+        if (!new_ids) return false;
+        view->ids = new_ids;
+        view->capacity = new_capacity;
+    }
+    view->ids[view->count++] = id;
+    return true;
+}
+
+void free_release_view(ReleaseView* view) {
+    free(view->ids);
+    view->ids = NULL;
+    view->count = 0;
+    view->capacity = 0;
+}
+
+static bool ensure_scratch(SearchIndex* index, int count) {
+    if (count <= index->scratch_capacity) return true;
+
+    int* new_scores = realloc(index->scores, count * sizeof(int));
+    if (!new_scores) return false;
+    index->scores = new_scores;
+    memset(index->scores + index->scratch_capacity, 0,
+           (count - index->scratch_capacity) * sizeof(int));
+
+    int* new_touched = realloc(index->touched, count * sizeof(int));
+    if (!new_touched) return false;
+    index->touched = new_touched;
+
+    index->scratch_capacity = count;
+    return true;
+}
+
+// Best score first, then the table's own order, whatever it is sorted by
+static int compare_matches(const void* a, const void* b) {
+    const SearchMatch* ma = (const SearchMatch*)a;
+    const SearchMatch* mb = (const SearchMatch*)b;
+
+    if (ma->score != mb->score) return mb->score - ma->score;
+    if (ma->row != mb->row) return (ma->row < mb->row) ? -1 : 1;
+    return ma->id - mb->id;
+}
+
+// Add id to view if its text contains query
+static bool scan_record(const SearchIndex* index, int id, const char* query, ReleaseView* view) {
+    if (id >= index->text_capacity || !index->texts[id].data) return true;
+    return !strstr(index->texts[id].data, query) || add_to_release_view(view, id);
+}
+
+// One or two characters have no trigram to look up; walk the table instead.
+// Records not yet merged into the order go last, as in the trigram path.
+static bool filter_by_scan(const SearchIndex* index, const ReleaseCollection* collection,
+                           const char* query, ReleaseView* view) {
+    for (int row = 0; row < collection->order->count; row++) {
+        if (!scan_record(index, collection->order->keys[row].id, query, view)) return false;
+    }
+    for (int id = collection->order->count; id < collection->count; id++) {
+        if (!scan_record(index, id, query, view)) return false;
+    }
+    return true;
+}
+
+// Bit i of masks[c] is set when query[i] == c
+static void build_query_masks(const char* query, int query_len, unsigned long long* masks) {
+    memset(masks, 0, 256 * sizeof(unsigned long long));
+    for (int i = 0; i < query_len; i++) masks[(unsigned char)query[i]] |= 1ull << i;
+}
+
+// Whether some substring of text is within one insertion, deletion or
+// substitution of the query (Wu-Manber shift-and). Bit i of exact is set
+// when query[0..i] ends at the current character; one_edit allows one edit.
+static bool within_one_edit(const unsigned long long* masks, int query_len, const char* text, int text_len) {
+    unsigned long long exact = 0, one_edit = 0;
+    unsigned long long last = 1ull << (query_len - 1);
+
+    for (int j = 0; j < text_len; j++) {
+        unsigned long long mask = masks[(unsigned char)text[j]];
+        unsigned long long next_exact = ((exact << 1) | 1) & mask;
+        one_edit = (((one_edit << 1) | 1) & mask)       // Match
+                   | exact                              // Extra character in text
+                   | (((exact | next_exact) << 1) | 1); // Substitution or missing character
+        exact = next_exact;
+        if (one_edit & last) return true;
+    }
+    return false;
+}
+
+// Fill view with the records matching query. Records containing the query
+// (ignoring case) come first, in table order. Longer queries also admit
+// records within one typo of it, ranked by how many query trigrams they
+// share. Only the posting lists of the query's trigrams are read, so the
+// cost follows the number of candidates rather than the collection size.
+bool filter_releases(const ReleaseCollection* collection, const char* query, ReleaseView* view) {
+    SearchIndex* index = collection->search;
+    char folded[MAX_SEARCH_LENGTH];
+    int len = 0;
+
+    view->count = 0;
+    while (query[len] && len < MAX_SEARCH_LENGTH - 1) {
+        folded[len] = fold_char(query[len]);
+        len++;
+    }
+    folded[len] = '\0';
+
+    if (len < 3) return filter_by_scan(index, collection, folded, view);
+    if (!ensure_scratch(index, collection->count)) return false;
+
+    // Distinct trigrams of the query
+    unsigned int trigrams[MAX_SEARCH_LENGTH];
+    int trigram_count = 0;
+    for (int i = 0; i + 3 <= len; i++) {
+        unsigned int key = pack_trigram(folded + i);
+        bool seen = false;
+        for (int k = 0; k < trigram_count && !seen; k++) seen = (trigrams[k] == key);
+        if (!seen) trigrams[trigram_count++] = key;
+    }
+
+    // Count, per record, how many of them it contains
+    int touched_count = 0;
+    for (int k = 0; k < trigram_count; k++) {
+        const PostingList* list = find_list(index, trigrams[k]);
+        if (!list) continue;
+        for (int i = 0; i < list->count; i++) {
+            int id = list->ids[i];
+            if (id >= collection->count) break;
+            if (index->scores[id]++ == 0) index->touched[touched_count++] = id;
+        }
+    }
+
+    // A typo destroys at most three trigrams, so a record missing more
+    // cannot be one typo away (the q-gram lemma). Too short a query would
+    // let every record through.
+    int min_shared = trigram_count;
+    if (len >= SEARCH_FUZZY_MIN_LENGTH) min_shared = trigram_count - 3;
+
+    SearchMatch* matches = touched_count ? malloc(touched_count * sizeof(SearchMatch)) : NULL;
+    int match_count = 0;
+    unsigned long long masks[256];
+    if (len >= SEARCH_FUZZY_MIN_LENGTH) build_query_masks(folded, len, masks);
+
+    for (int i = 0; i < touched_count; i++) {
+        int id = index->touched[i];
+        int score = index->scores[id];
+        index->scores[id] = 0;
+        if (!matches || score < min_shared) continue;
+
+        // Sharing trigrams is necessary but not sufficient; check the text
+        const SearchText* text = &index->texts[id];
+        if (score == trigram_count && strstr(text->data, folded)) {
+            score = trigram_count + 1;
+        } else if (len < SEARCH_FUZZY_MIN_LENGTH || !within_one_edit(masks, len, text->data, text->length)) {
+            continue;
+        }
+        matches[match_count].id = id;
+        matches[match_count].score = score;
+        // Records not yet merged into the order go last
+        matches[match_count].row = (id < collection->order->count) ? collection->rows[id] : INT_MAX;
+        match_count++;
+    }
+    if (touched_count && !matches) return false;
+
+    if (match_count > 1) qsort(matches, match_count, sizeof(SearchMatch), compare_matches);
+
+    bool ok = true;
+    for (int i = 0; i < match_count && ok; i++) ok = add_to_release_view(view, matches[i].id);
+    free(matches);
+    return ok;
+}
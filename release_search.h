@@ -0,0 +1,31 @@
+#ifndef RELEASE_SEARCH_H
+#define RELEASE_SEARCH_H
+
+#include <stdbool.h>
+#include "requests.h"
+
+#define MAX_SEARCH_LENGTH 64
+#define SEARCH_INITIAL_BUCKETS 4096    // Power of two
+#define SEARCH_FUZZY_MIN_LENGTH 6      // Shorter queries only match exactly
+
+// Trigram index over "owner/repo tag" of every record in a collection,
+// case-folded. Each distinct trigram maps to the ascending list of record
+// numbers containing it; records are appended as they arrive and never
+// change, so the lists only ever grow at the end.
+
+// Rows that pass the filter, as record numbers in display order
+typedef struct {
+    int* ids;
+    int count;
+    int capacity;
+} ReleaseView;
+
+// Function declarations
+SearchIndex* create_search_index(void);
+void free_search_index(SearchIndex* index);
+bool index_release(SearchIndex* index, int id, const Release* release);
+bool filter_releases(const ReleaseCollection* collection, const char* query, ReleaseView* view);
+bool add_to_release_view(ReleaseView* view, int id);
+void free_release_view(ReleaseView* view);
+
+#endif // RELEASE_SEARCH_H
@@ -0,0 +1,296 @@
+#include "release_sort.h"
+#include "asset_classifier.h"
+#include "string_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ORDER_INITIAL_CAPACITY 64
+#define FACET_INITIAL_WORDS 16
+#define RECENT_REFRESH_SECONDS 60
+#define NAME_SEPARATOR '\x01'   // Sorts below every character of a name
+
+typedef struct {
+    const ReleaseCollection* collection;
+    SortField field;
+    bool descending;
+} SortContext;
+
+static const char* g_facet_labels[FACET_COUNT] = { "Pre", "Win", "7d" };
+
+static char fold_char(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+static int compare_folded(const char* a, const char* b) {
+    while (*a && fold_char(*a) == fold_char(*b)) {
+        a++;
+        b++;
+    }
+    return (unsigned char)fold_char(*a) - (unsigned char)fold_char(*b);
+}
+
+// Pack the first eight case-folded bytes of first, then (if given) the
+// separator and second, big-endian, so comparing keys compares prefixes
+static unsigned long long pack_prefix(const char* first, const char* second) {
+    unsigned long long key = 0;
+    int bytes = 0;
+
+    for (; *first && bytes < 8; first++, bytes++) key = (key << 8) | (unsigned char)fold_char(*first);
+    if (second && bytes < 8) {
+        key = (key << 8) | (unsigned char)NAME_SEPARATOR;
+        bytes++;
+        for (; *second && bytes < 8; second++, bytes++) key = (key << 8) | (unsigned char)fold_char(*second);
+    }
+    return key << (8 * (8 - bytes));
+}
+
+static int count_bits(unsigned int bits) {
+    int count = 0;
+    for (; bits; bits &= bits - 1) count++;
+    return count;
+}
+
+static void make_key(const ReleaseCollection* collection, SortField field, int id, ReleaseKey* key) {
+    const Release* release = get_release(collection, id);
+
+    key->id = id;
+    switch (field) {
+        case SORT_BY_REPO:
+            key->key = pack_prefix(get_interned_string(release->owner), get_interned_string(release->repo));
+            break;
+        case SORT_BY_TAG:
+            key->key = pack_prefix(get_interned_string(release->tag), NULL);
+            break;
+        case SORT_BY_AGE:
+            key->key = (unsigned long long)release->created_at;
+            break;
+        case SORT_BY_TYPE:
+            key->key = (release->flags & RELEASE_PRERELEASE) ? 1 : 0;
+            break;
+        default:
+            // Most platforms first when descending; equal counts by platform
+            key->key = ((unsigned long long)count_bits(release->platforms) << 8) | release->platforms;
+            break;
+    }
+}
+
+static int compare_keys(const SortContext* context, const ReleaseKey* a, const ReleaseKey* b) {
+    const Release* ra = get_release(context->collection, a->id);
+    const Release* rb = get_release(context->collection, b->id);
+    int result = 0;
+
+    if (a->key != b->key) {
+        result = (a->key < b->key) ? -1 : 1;
+    } else if (context->field == SORT_BY_REPO) {
+        // Equal prefixes: the full names decide
+        result = compare_folded(get_interned_string(ra->owner), get_interned_string(rb->owner));
+        if (result == 0) result = compare_folded(get_interned_string(ra->repo), get_interned_string(rb->repo));
+    } else if (context->field == SORT_BY_TAG) {
+        result = compare_folded(get_interned_string(ra->tag), get_interned_string(rb->tag));
+    }
+    if (context->descending) result = -result;
+    if (result != 0) return result;
+
+    // Ties: newest first, then arrival order, whichever way the column runs
+    if (ra->created_at != rb->created_at) return (ra->created_at > rb->created_at) ? -1 : 1;
+    return (a->id < b->id) ? -1 : (a->id > b->id);
+}
+
+static void merge_runs(const SortContext* context, const ReleaseKey* a, int a_count,
+                       const ReleaseKey* b, int b_count, ReleaseKey* out) {
+    int i = 0, j = 0, k = 0;
+
+    while (i < a_count && j < b_count) {
+        out[k++] = (compare_keys(context, &b[j], &a[i]) < 0) ? b[j++] : a[i++];
+    }
+    while (i < a_count) out[k++] = a[i++];
+    while (j < b_count) out[k++] = b[j++];
+}
+
+// Bottom-up merge sort; returns whichever of the two buffers holds the result
+static ReleaseKey* sort_keys(const SortContext* context, ReleaseKey* keys, ReleaseKey* scratch, int count) {
+    for (int width = 1; width < count; width *= 2) {
+        for (int start = 0; start < count; start += 2 * width) {
+            int mid = (start + width < count) ? start + width : count;
+            int end = (start + 2 * width < count) ? start + 2 * width : count;
+            merge_runs(context, keys + start, mid - start, keys + mid, end - mid, scratch + start);
+        }
+        ReleaseKey* swap = keys;
+        keys = scratch;
+        scratch = swap;
+    }
+    return keys;
+}
+
+// Bring one order up to the collection: sort the records added since it
+// was last used and merge them in from the back, in place
+static bool sync_order(ReleaseCollection* collection, int index) {
+    ReleaseOrder* order = &collection->orders[index];
+    int pending = collection->count - order->count;
+    if (pending <= 0) return true;
+
+    if (collection->count > order->capacity) {
+        int new_capacity = order->capacity ? order->capacity : ORDER_INITIAL_CAPACITY;
+        while (new_capacity < collection->count) new_capacity *= 2;
+        ReleaseKey* new_keys = realloc(order->keys, new_capacity * sizeof(ReleaseKey));
+        if (!new_keys) return false;
+        order->keys = new_keys;
+        order->capacity = new_capacity;
+    }
+
+    ReleaseKey* buffer = malloc(2 * (size_t)pending * sizeof(ReleaseKey));
+    if (!buffer) return false;
+
+    SortContext context = { collection, (SortField)(index / 2), (index % 2) != 0 };
+    for (int i = 0; i < pending; i++) make_key(collection, context.field, order->count + i, &buffer[i]);
+    ReleaseKey* added = sort_keys(&context, buffer, buffer + pending, pending);
+
+    int i = order->count - 1, j = pending - 1, k = collection->count - 1;
+    while (j >= 0) {
+        if (i >= 0 && compare_keys(&context, &order->keys[i], &added[j]) > 0) {
+            order->keys[k--] = order->keys[i--];
+        } else {
+            order->keys[k--] = added[j--];
+        }
+    }
+    order->count = collection->count;
+
+    free(buffer);
+    return true;
+}
+
+// Row of every record in the order shown, for ranking search results
+static bool update_rows(ReleaseCollection* collection) {
+    const ReleaseOrder* order = collection->order;
+
+    if (order->count > collection->row_capacity) {
+        int* new_rows = realloc(collection->rows, order->capacity * sizeof(int));
+        if (!new_rows) return false;
+        collection->rows = new_rows;
+        collection->row_capacity = order->capacity;
+    }
+    for (int row = 0; row < order->count; row++) collection->rows[order->keys[row].id] = row;
+    return true;
+}
+
+// Start out newest first, as the table always used to be
+bool init_release_orders(ReleaseCollection* collection, int initial_capacity) {
+    ReleaseOrder* order = &collection->orders[SORT_BY_AGE * 2 + 1];
+
+    order->keys = malloc(initial_capacity * sizeof(ReleaseKey));
+    if (!order->keys) return false;
+    order->capacity = initial_capacity;
+    collection->order = order;
+    collection->recent_since = time(NULL) - FACET_RECENT_DAYS * 86400;
+    return true;
+}
+
+void free_release_orders(ReleaseCollection* collection) {
+    for (int i = 0; i < SORT_ORDER_COUNT; i++) {
+        free(collection->orders[i].keys);
+        collection->orders[i].keys = NULL;
+    }
+    for (int i = 0; i < FACET_COUNT; i++) {
+        free(collection->facets[i]);
+        collection->facets[i] = NULL;
+    }
+    free(collection->rows);
+    collection->rows = NULL;
+}
+
+// Show another order. Orders never shown are sorted in full here; the rest
+// only merge in what arrived since. On failure the current order stays.
+bool set_release_order(ReleaseCollection* collection, SortField field, bool descending) {
+    int index = field * 2 + (descending ? 1 : 0);
+    if (!sync_order(collection, index)) return false;
+
+    collection->order = &collection->orders[index];
+    return update_rows(collection);
+}
+
+// Merge newly added records into the order shown; the others catch up
+// when they are next shown
+bool sync_release_order(ReleaseCollection* collection) {
+    int index = (int)(collection->order - collection->orders);
+    return sync_order(collection, index) && update_rows(collection);
+}
+
+static void set_facet_bit(ReleaseCollection* collection, int facet, int id, bool on) {
+    unsigned long long bit = 1ull << (id % 64);
+    if (on) {
+        collection->facets[facet][id / 64] |= bit;
+    } else {
+        collection->facets[facet][id / 64] &= ~bit;
+    }
+}
+
+bool set_release_facets(ReleaseCollection* collection, int id) {
+    if (id / 64 >= collection->facet_words) {
+        int new_words = collection->facet_words ? collection->facet_words * 2 : FACET_INITIAL_WORDS;
+        while (new_words <= id / 64) new_words *= 2;
+        for (int i = 0; i < FACET_COUNT; i++) {
+            unsigned long long* new_bits = realloc(collection->facets[i], new_words * sizeof(unsigned long long));
+            if (!new_bits) return false;
+            memset(new_bits + collection->facet_words, 0,
+                   (new_words - collection->facet_words) * sizeof(unsigned long long));
+            collection->facets[i] = new_bits;
+        }
+        collection->facet_words = new_words;
+    }
+
+    const Release* release = get_release(collection, id);
+    set_facet_bit(collection, 0, id, (release->flags & RELEASE_PRERELEASE) != 0);
+    set_facet_bit(collection, 1, id, (release->platforms & ASSET_WINDOWS) != 0);
+    set_facet_bit(collection, 2, id, release->created_at >= collection->recent_since);
+    return true;
+}
+
+// Releases age out of the recent facet as time passes; recompute its bits
+// once the cutoff has moved on noticeably
+static void refresh_recent_facet(ReleaseCollection* collection) {
+    time_t since = time(NULL) - FACET_RECENT_DAYS * 86400;
+    if (since - collection->recent_since < RECENT_REFRESH_SECONDS || !collection->facets[2]) return;
+
+    collection->recent_since = since;
+    for (int id = 0; id < collection->count && id / 64 < collection->facet_words; id++) {
+        set_facet_bit(collection, 2, id, get_release(collection, id)->created_at >= since);
+    }
+}
+
+static bool has_facets(const ReleaseCollection* collection, int id, unsigned int facets) {
+    for (int i = 0; i < FACET_COUNT; i++) {
+        if (!(facets & (1u << i))) continue;
+        if (id / 64 >= collection->facet_words) return false;
+        if (!(collection->facets[i][id / 64] & (1ull << (id % 64)))) return false;
+    }
+    return true;
+}
+
+// Fill view with the rows of the order shown that have every facet
+bool select_releases(ReleaseCollection* collection, unsigned int facets, ReleaseView* view) {
+    if (facets & FACET_RECENT) refresh_recent_facet(collection);
+
+    view->count = 0;
+    for (int row = 0; row < collection->order->count; row++) {
+        int id = collection->order->keys[row].id;
+        if (has_facets(collection, id, facets) && !add_to_release_view(view, id)) return false;
+    }
+    return true;
+}
+
+// Drop the records of view missing any of the facets, keeping their order
+void keep_faceted_releases(ReleaseCollection* collection, unsigned int facets, ReleaseView* view) {
+    if (facets & FACET_RECENT) refresh_recent_facet(collection);
+
+    int kept = 0;
+    for (int i = 0; i < view->count; i++) {
+        if (has_facets(collection, view->ids[i], facets)) view->ids[kept++] = view->ids[i];
+    }
+    view->count = kept;
+}
+
+// Footer label for facet bit (1 << index)
+const char* facet_label(int index) {
+    return (index >= 0 && index < FACET_COUNT) ? g_facet_labels[index] : "";
+}
@@ -0,0 +1,25 @@
+#ifndef RELEASE_SORT_H
+#define RELEASE_SORT_H
+
+#include <stdbool.h>
+#include "requests.h"
+#include "release_search.h"
+
+// Sort orders and facets of a ReleaseCollection. Each order is an array
+// of compact keys, sorted in full only the first time it is shown; after
+// that new records are sorted among themselves and merged in, so going
+// back to an order costs a merge of what arrived in between. Ties on the
+// sorted column always fall back to newest first, then arrival order.
+// Facets are bitsets with one bit per record number.
+
+// Function declarations
+bool init_release_orders(ReleaseCollection* collection, int initial_capacity);
+void free_release_orders(ReleaseCollection* collection);
+bool set_release_order(ReleaseCollection* collection, SortField field, bool descending);
+bool sync_release_order(ReleaseCollection* collection);
+bool set_release_facets(ReleaseCollection* collection, int id);
+bool select_releases(ReleaseCollection* collection, unsigned int facets, ReleaseView* view);
+void keep_faceted_releases(ReleaseCollection* collection, unsigned int facets, ReleaseView* view);
+const char* facet_label(int index);
+
+#endif // RELEASE_SORT_H
@@ -1,180 +1,200 @@
 #include "requests.h"
+#include "release_cache.h"
+#include "json_scan.h"
+#include "asset_classifier.h"
+#include "release_queue.h"
+#include "string_table.h"
+#include "release_search.h"
+#include "release_sort.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
-#include <Windows.h>
-#include <winhttp.h>
-#pragma comment(lib, "winhttp.lib")
 
-// Simple JSON string extraction function
-char* extract_json_string(const char* json, const char* key) {
-    char search_key[256];
-    snprintf(search_key, sizeof(search_key), "\"%s\":", key);
-    
-    char* start = strstr(json, search_key);
-    if (!start) return NULL;
-    
-    start += strlen(search_key);
-    
-    // Skip whitespace
-    while (*start == ' ' || *start == '\t' || *start == '\n') start++;
-    
-    if (*start != '"') return NULL;
-    start++; // Skip opening quote
-    
-    char* end = start;
-    while (*end && *end != '"') {
-        if (*end == '\\' && *(end + 1)) {
-            end += 2; // Skip escaped character
-        } else {
-            end++;
-        }
+#define JSON_INITIAL_TOKENS 256
+
+static int add_json_token(JsonDocument* doc, JsonType type, int start, int parent) {
+    if (doc->count >= doc->capacity) {
+        int new_capacity = doc->capacity ? doc->capacity * 2 : JSON_INITIAL_TOKENS;
+        JsonToken* new_tokens = realloc(doc->tokens, new_capacity * sizeof(JsonToken));
+        if (!new_tokens) return -1;
+        doc->tokens = new_tokens;
+        doc->capacity = new_capacity;
     }
-    
-    if (*end != '"') return NULL;
-    
-    size_t len = end - start;
-    char* result = malloc(len + 1);
-    if (!result) return NULL;
-    
-    strncpy(result, start, len);
-    result[len] = '\0';
-    
-    return result;
+
+    JsonToken* token = &doc->tokens[doc->count];
+    token->type = type;
+    token->start = start;
+    token->end = start;
+    token->parent = parent;
+    token->depth = parent >= 0 ? doc->tokens[parent].depth + 1 : 0;
+    token->next = doc->count + 1;
+    return doc->count++;
 }
 
-// Simple JSON boolean extraction function
-bool extract_json_bool(const char* json, const char* key) {
-    char search_key[256];
-    snprintf(search_key, sizeof(search_key), "\"%s\":", key);
-    
-    char* start = strstr(json, search_key);
-    if (!start) return false;
-    
-    start += strlen(search_key);
-    
-    // Skip whitespace
-    while (*start == ' ' || *start == '\t' || *start == '\n') start++;
-    
-    return (strncmp(start, "true", 4) == 0);
+static bool is_json_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ':';
 }
 
-// Check if asset name contains Windows-related keywords
-bool is_windows_asset(const char* name) {
-    if (!name) return false;
-    
-    // Convert to lowercase for case-insensitive comparison
-    char lower_name[512];
-    int len = strlen(name);
-    if (len >= sizeof(lower_name)) len = sizeof(lower_name) - 1;
-    
-    for (int i = 0; i < len; i++) {
-        lower_name[i] = tolower(name[i]);
-    }
-    lower_name[len] = '\0';
-    
-    // Check for .exe extension
-    if (strstr(lower_name, ".exe")) return true;
-    if (strstr(lower_name, ".msi")) return true;
-    
-    // Check for Windows-related keywords
-    if (strstr(lower_name, "windows")) return true;
-    if (strstr(lower_name, "win")) return true;
-    if (strstr(lower_name, "msvc")) return true;
-    if (strstr(lower_name, "window")) return true;
-    
-    return false;
+// Numbers, true, false and null sit in the gaps between structural
+// characters, so only those short gaps are examined byte by byte
+static bool add_json_primitive(const char* json, size_t from, size_t to, JsonDocument* doc, int parent) {
+    while (from < to && is_json_space(json[from])) from++;
+    while (to > from && is_json_space(json[to - 1])) to--;
+    if (from == to) return true;
+
+    int index = add_json_token(doc, JSON_PRIMITIVE, (int)from, parent);
+    if (index < 0) return false;
+    doc->tokens[index].end = (int)to;
+    return true;
 }
 
-// Check if release has Windows assets
-bool check_windows_assets(const char* json) {
-    // Look for assets array
-    char* assets_start = strstr(json, "\"assets\":");
-    if (!assets_start) return false;
-    
-    // Find the opening bracket of the array
-    char* bracket = strchr(assets_start, '[');
-    if (!bracket) return false;
-    
-    // Find the closing bracket
-    char* end_bracket = bracket;
-    int bracket_count = 0;
-    while (*end_bracket) {
-        if (*end_bracket == '[') bracket_count++;
-        else if (*end_bracket == ']') {
-            bracket_count--;
-            if (bracket_count == 0) break;
-        }
-        end_bracket++;
-    }
-    
-    if (bracket_count != 0) return false;
-    
-    // Extract assets section
-    size_t assets_len = end_bracket - bracket + 1;
-    char* assets_json = malloc(assets_len + 1);
-    if (!assets_json) return false;
-    
-    strncpy(assets_json, bracket, assets_len);
-    assets_json[assets_len] = '\0';
-    
-    // Look for asset names
-    char* name_pos = assets_json;
-    while ((name_pos = strstr(name_pos, "\"name\":")) != NULL) {
-        name_pos += 7; // Skip "name":
+// Tokenize a whole document in one pass over its structural index.
+// Containers record where their subtree ends, so a caller can step over any
+// value without rescanning it. Strings are left escaped; their offsets
+// exclude the quotes.
+bool json_parse(const char* json, size_t len, JsonDocument* doc) {
+    JsonIndex index = {0};
+    int parent = -1;
+    size_t cursor = 0;  // First byte not yet consumed
+    bool ok = json_build_index(json, len, &index);
+    
+    doc->count = 0;
+    
+    for (size_t n = 0; ok && n < index.count; n++) {
+        size_t pos = index.positions[n];
+        char c = json[pos];
+        int token;
         
-        // Skip whitespace
-        while (*name_pos == ' ' || *name_pos == '\t' || *name_pos == '\n') name_pos++;
+        if (!add_json_primitive(json, cursor, pos, doc, parent)) {
+            ok = false;
+            break;
+        }
+        cursor = pos + 1;
         
-        if (*name_pos == '"') {
-            name_pos++; // Skip opening quote
-            
-            // Find closing quote
-            char* name_end = name_pos;
-            while (*name_end && *name_end != '"') {
-                if (*name_end == '\\' && *(name_end + 1)) {
-                    name_end += 2; // Skip escaped character
-                } else {
-                    name_end++;
+        switch (c) {
+            case '{':
+            case '[':
+                token = add_json_token(doc, c == '{' ? JSON_OBJECT : JSON_ARRAY, (int)pos, parent);
+                if (token < 0) ok = false;
+                parent = token;
+                break;
+                
+            case '}':
+            case ']':
+                if (parent < 0 || doc->tokens[parent].type != (c == '}' ? JSON_OBJECT : JSON_ARRAY)) {
+                    ok = false;
+                    break;
                 }
-            }
-            
-            if (*name_end == '"') {
-                // Extract name and check
-                size_t name_len = name_end - name_pos;
-                char asset_name[512];
-                if (name_len < sizeof(asset_name)) {
-                    strncpy(asset_name, name_pos, name_len);
-                    asset_name[name_len] = '\0';
-                    
-                    if (is_windows_asset(asset_name)) {
-                        free(assets_json);
-                        return true;
+                doc->tokens[parent].end = (int)pos + 1;
+                doc->tokens[parent].next = doc->count;
+                parent = doc->tokens[parent].parent;
+                break;
+                
+            case '"': {
+                // Walk the indexed characters up to the closing quote; an
+                // escape also swallows the indexed character right after it
+                size_t close = 0;
+                for (n++; n < index.count; n++) {
+                    size_t p = index.positions[n];
+                    if (json[p] == '"') {
+                        close = p;
+                        break;
                     }
+                    if (json[p] == '\\' && n + 1 < index.count && index.positions[n + 1] == p + 1) n++;
                 }
+                if (close == 0) {
+                    ok = false;
+                    break;
+                }
+                
+                token = add_json_token(doc, JSON_STRING, (int)pos + 1, parent);
+                if (token < 0) {
+                    ok = false;
+                    break;
+                }
+                doc->tokens[token].end = (int)close;
+                cursor = close + 1;
+                break;
             }
-            name_pos = name_end;
+                
+            default:
+                // Commas separate values; a stray backslash is ignored
+                break;
         }
     }
     
-    free(assets_json);
-    return false;
+    if (ok) ok = add_json_primitive(json, cursor, len, doc, parent);
+    free_json_index(&index);
+    return ok && parent == -1 && doc->count > 0;
+}
+
+void free_json_document(JsonDocument* doc) {
+    free(doc->tokens);
+    doc->tokens = NULL;
+    doc->count = doc->capacity = 0;
+}
+
+bool json_token_equals(const char* json, const JsonToken* token, const char* text) {
+    size_t len = strlen(text);
+    return token->type == JSON_STRING && (size_t)(token->end - token->start) == len &&
+           strncmp(json + token->start, text, len) == 0;
+}
+
+// Copy a string or primitive token, truncating to size
+void json_token_copy(const char* json, const JsonToken* token, char* dest, size_t size) {
+    size_t len = token->end - token->start;
+    if (len >= size) len = size - 1;
+    memcpy(dest, json + token->start, len);
+    dest[len] = '\0';
+}
+
+// Value stored under key in an object, or -1
+int json_object_get(const char* json, const JsonDocument* doc, int object, const char* key) {
+    if (object < 0 || doc->tokens[object].type != JSON_OBJECT) return -1;
+
+    for (int k = object + 1; k < doc->tokens[object].next; ) {
+        int value = k + 1;
+        if (value >= doc->tokens[object].next) break;
+        if (json_token_equals(json, &doc->tokens[k], key)) return value;
+        k = doc->tokens[value].next;
+    }
+    return -1;
+}
+
+// Classify the names in an assets list where they lie in the document.
+// REST returns an array of assets; GraphQL returns a connection object
+// whose nodes array holds them.
+static unsigned int classify_asset_tokens(const char* json, const JsonDocument* doc, int assets) {
+    if (assets >= 0 && doc->tokens[assets].type == JSON_OBJECT) {
+        assets = json_object_get(json, doc, assets, "nodes");
+    }
+    if (assets < 0 || doc->tokens[assets].type != JSON_ARRAY) return 0;
+
+    unsigned int platforms = 0;
+    for (int item = assets + 1; item < doc->tokens[assets].next; item = doc->tokens[item].next) {
+        int name = json_object_get(json, doc, item, "name");
+        if (name < 0 || doc->tokens[name].type != JSON_STRING) continue;
+
+        const JsonToken* token = &doc->tokens[name];
+        platforms |= classify_asset_name(json + token->start, token->end - token->start);
+    }
+    return platforms;
 }
 
 ReleaseCollection* create_release_collection(int initial_capacity) {
     ReleaseCollection* collection = calloc(1, sizeof(ReleaseCollection));
     if (!collection) return NULL;
     
-    collection->releases = calloc(initial_capacity, sizeof(Release));
-    if (!collection->releases) {
+    if (initial_capacity < 1) initial_capacity = 1;
+    collection->search = create_search_index();
+    if (!collection->search || !init_release_orders(collection, initial_capacity)) {
+        free_search_index(collection->search);
+        free_release_orders(collection);
         free(collection);
         return NULL;
     }
     
-    collection->capacity = initial_capacity;
     collection->count = 0;
-    InitializeCriticalSection(&collection->mutex);
     
     return collection;
 }
@@ -182,25 +202,22 @@ ReleaseCollection* create_release_collection(int initial_capacity) {
 void free_release_collection(ReleaseCollection* collection) {
     if (!collection) return;
     
-    EnterCriticalSection(&collection->mutex);
-    
-    if (collection->releases) {
-        for (int i = 0; i < collection->count; i++) {
-            if (collection->releases[i].body) {
-                free(collection->releases[i].body);
-            }
-        }
-        free(collection->releases);
+    for (int i = 0; i < collection->count; i++) {
+        free_release_text(get_release(collection, i));
     }
-    
-    LeaveCriticalSection(&collection->mutex);
-    DeleteCriticalSection(&collection->mutex);
+    for (int i = 0; i < collection->block_count; i++) {
+        free(collection->blocks[i]);
+    }
+    free(collection->blocks);
+    free_release_orders(collection);
+    free_search_index(collection->search);
     free(collection);
 }
 
-void calculate_time_diff(Release* release) {
+// Relative age such as "3d ago" or "1y2mo ago", computed when displayed
+void format_release_age(time_t created_at, char* buf, size_t size) {
     time_t current_time = time(NULL);
-    double diff_seconds = difftime(current_time, release->created_at);
+    double diff_seconds = difftime(current_time, created_at);
     int seconds = (int)diff_seconds;
     int minutes = seconds / 60;
     int hours = minutes / 60;
@@ -208,277 +225,496 @@ void calculate_time_diff(Release* release) {
     int years = days / 365;
     int months = (days % 365) / 30;
     int rem_days = (days % 365) % 30;
-    char buf[MAX_TIME_DIFF_LENGTH] = "";
 
+    buf[0] = '\0';
     if (years > 0) {
-        snprintf(buf, sizeof(buf), "%dy", years);
+        snprintf(buf, size, "%dy", years);
     }
     if (months > 0) {
         size_t len = strlen(buf);
-        snprintf(buf + len, sizeof(buf) - len, "%dmo", months);
+        snprintf(buf + len, size - len, "%dmo", months);
     }
     if (rem_days > 0 && years == 0) {
         size_t len = strlen(buf);
-        snprintf(buf + len, sizeof(buf) - len, "%dd", rem_days);
+        snprintf(buf + len, size - len, "%dd", rem_days);
     }
     if (days >= 1 && years == 0 && months == 0) {
-        snprintf(release->time_difference, MAX_TIME_DIFF_LENGTH, "%dd ago", days);
+        snprintf(buf, size, "%dd ago", days);
         return;
     }
     if (years > 0 || months > 0) {
         size_t len = strlen(buf);
-        snprintf(buf + len, sizeof(buf) - len, " ago");
-        strncpy(release->time_difference, buf, MAX_TIME_DIFF_LENGTH);
+        snprintf(buf + len, size - len, " ago");
         return;
     }
     if (hours > 0) {
-        snprintf(release->time_difference, MAX_TIME_DIFF_LENGTH, "%dh ago", hours);
+        snprintf(buf, size, "%dh ago", hours);
     } else if (minutes > 0) {
-        snprintf(release->time_difference, MAX_TIME_DIFF_LENGTH, "%dmin ago", minutes);
+        snprintf(buf, size, "%dmin ago", minutes);
     } else {
-        snprintf(release->time_difference, MAX_TIME_DIFF_LENGTH, "%ds ago", seconds);
+        snprintf(buf, size, "%ds ago", seconds);
+    }
+}
+
+// When the text format_release_age gives for created_at next changes:
+// the end of the current second, minute, hour or day of age. Months and
+// years are counted in days, so a day is the coarsest bucket.
+time_t next_age_change(time_t created_at, time_t now) {
+    time_t age = now - created_at;
+    time_t unit = 1;
+    
+    if (age >= 86400) {
+        unit = 86400;
+    } else if (age >= 3600) {
+        unit = 3600;
+    } else if (age >= 60) {
+        unit = 60;
     }
+    if (age < 0) return now + 1;
+    return created_at + (age / unit + 1) * unit;
 }
 
+// Record by the number it was added under
+Release* get_release(const ReleaseCollection* collection, int id) {
+    return &collection->blocks[id / RELEASE_BLOCK_SIZE][id % RELEASE_BLOCK_SIZE];
+}
+
+// Record shown in the given table row (0-based) of the order shown
+Release* get_release_at(const ReleaseCollection* collection, int row) {
+    return get_release(collection, collection->order->keys[row].id);
+}
+
+// Store the record in the next free slot; it is never moved afterwards.
+// It joins the table order at the next sync_release_order.
 bool add_release_to_collection(ReleaseCollection* collection, Release* release) {
-    EnterCriticalSection(&collection->mutex);
-    
-    if (collection->count >= collection->capacity) {
-        int new_capacity = collection->capacity * 2;
-        Release* new_releases = realloc(collection->releases, 
-                                      new_capacity * sizeof(Release));
-        if (!new_releases) {
-            LeaveCriticalSection(&collection->mutex);
-            return false;
-        }
-        collection->releases = new_releases;
-        collection->capacity = new_capacity;
+    int id = collection->count;
+    
+    if (id / RELEASE_BLOCK_SIZE >= collection->block_count) {
+        Release** new_blocks = realloc(collection->blocks,
+                                       (collection->block_count + 1) * sizeof(Release*));
+        if (!new_blocks) return false;
+        collection->blocks = new_blocks;
+        
+        collection->blocks[collection->block_count] = malloc(RELEASE_BLOCK_SIZE * sizeof(Release));
+        if (!collection->blocks[collection->block_count]) return false;
+        collection->block_count++;
     }
     
-    collection->releases[collection->count] = *release;
+    *get_release(collection, id) = *release;
     collection->count++;
     
-    LeaveCriticalSection(&collection->mutex);
+    // The row still shows if these fail; it just cannot be filtered for
+    set_release_facets(collection, id);
+    index_release(collection->search, id, release);
+    
     return true;
 }
 
-void fetch_latest_release(RepoInfo* repo, ReleaseCollection* collection, const char* auth_token) {
-    HINTERNET hSession = NULL;
-    HINTERNET hConnect = NULL;
-    HINTERNET hRequest = NULL;
-    DWORD dwSize = 0;
-    DWORD dwDownloaded = 0;
-    DWORD dwStatusCode = 0;
-    DWORD dwStatusCodeSize = sizeof(dwStatusCode);
-    
-    char* pszOutBuffer = NULL;
-    BOOL bResults = FALSE;
-    
-    // Initialize WinHTTP
-    hSession = WinHttpOpen(L"GReleaseMon-c/1.0", 
-                          WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
-                          WINHTTP_NO_PROXY_NAME,
-                          WINHTTP_NO_PROXY_BYPASS,
-                          0);
-    
-    if (!hSession) {
-        fprintf(stderr, "Error: Failed to initialize WinHTTP\n");
-        return;
+StringView make_string_view(const char* text) {
+    StringView view = { text, text ? (int)strlen(text) : 0 };
+    return view;
+}
+
+bool string_view_equals(StringView view, const char* text) {
+    size_t len = strlen(text);
+    return view.data && (size_t)view.length == len && memcmp(view.data, text, len) == 0;
+}
+
+// Copy the two strings into one details block owned by the release and
+// point the views there; this is the only allocation a parsed release needs
+bool set_release_text(Release* release, StringView url, StringView body) {
+    size_t size = (size_t)url.length + body.length + 2;
+    ReleaseDetails* details = malloc(sizeof(ReleaseDetails) + size);
+    
+    release->details = details;
+    if (!details) return false;
+    
+    // Each field is NUL-terminated too, so a view can be printed with %s
+    char* text = details->text;
+    StringView* fields[2] = { &details->url, &details->body };
+    StringView sources[2] = { url, body };
+    for (int i = 0; i < 2; i++) {
+        fields[i]->data = sources[i].data ? text : NULL;
+        fields[i]->length = sources[i].length;
+        if (sources[i].length > 0) memcpy(text, sources[i].data, sources[i].length);
+        text[sources[i].length] = '\0';
+        text += sources[i].length + 1;
     }
-    
-    // Connect to GitHub API
-    hConnect = WinHttpConnect(hSession, L"api.github.com", INTERNET_DEFAULT_HTTPS_PORT, 0);
-    
-    if (!hConnect) {
-        fprintf(stderr, "Error: Failed to connect to GitHub API\n");
-        goto cleanup;
+    return true;
+}
+
+// Deep copy: dest gets its own details block
+bool copy_release(Release* dest, const Release* src) {
+    *dest = *src;
+    if (!src->details) return true;
+    return set_release_text(dest, src->details->url, src->details->body);
+}
+
+void free_release_text(Release* release) {
+    free(release->details);
+    release->details = NULL;
+}
+
+StringView get_release_url(const Release* release) {
+    return release->details ? release->details->url : make_string_view(NULL);
+}
+
+StringView get_release_body(const Release* release) {
+    return release->details ? release->details->body : make_string_view(NULL);
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Read the four hex digits of a \u escape starting at data[i]
+static long read_hex4(StringView view, int i) {
+    if (i + 4 > view.length) return -1;
+    
+    long code = 0;
+    for (int k = 0; k < 4; k++) {
+        int digit = hex_value(view.data[i + k]);
+        if (digit < 0) return -1;
+        code = code * 16 + digit;
     }
-    
-    // Build request path
-    wchar_t wszPath[512];
-    swprintf(wszPath, sizeof(wszPath)/sizeof(wchar_t), 
-             L"/repos/%hs/%hs/releases/latest", repo->owner, repo->repo);
-    
-    // Create HTTP request
-    hRequest = WinHttpOpenRequest(hConnect, L"GET", wszPath, NULL, 
-                                 WINHTTP_NO_REFERER, WINHTTP_DEFAULT_ACCEPT_TYPES, 
-                                 WINHTTP_FLAG_SECURE);
-    
-    if (!hRequest) {
-        fprintf(stderr, "Error: Failed to create HTTP request\n");
-        goto cleanup;
+    return code;
+}
+
+static int encode_utf8(unsigned long code, char* out) {
+    if (code < 0x80) {
+        out[0] = (char)code;
+        return 1;
+    } else if (code < 0x800) {
+        out[0] = (char)(0xC0 | (code >> 6));
+        out[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    } else if (code < 0x10000) {
+        out[0] = (char)(0xE0 | (code >> 12));
+        out[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (code & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (code >> 18));
+    out[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (code & 0x3F));
+    return 4;
+}
+
+// Decode the JSON escapes of a view into dest (UTF-8, NUL-terminated,
+// truncated to size). The result is never longer than the escaped input.
+size_t unescape_json(StringView view, char* dest, size_t size) {
+    size_t out = 0;
+    if (size == 0) return 0;
+    
+    for (int i = 0; i < view.length; i++) {
+        char decoded[4];
+        int n = 1;
+        
+        decoded[0] = view.data[i];
+        if (view.data[i] == '\\' && i + 1 < view.length) {
+            char c = view.data[++i];
+            switch (c) {
+                case 'n': decoded[0] = '\n'; break;
+                case 't': decoded[0] = '\t'; break;
+                case 'r': decoded[0] = '\r'; break;
+                case 'b': decoded[0] = '\b'; break;
+                case 'f': decoded[0] = '\f'; break;
+                case 'u': {
+                    long code = read_hex4(view, i + 1);
+                    if (code < 0) {
+                        decoded[0] = c;
+                        break;
+                    }
+                    i += 4;
+                    
+                    // Characters outside the BMP arrive as a surrogate pair
+                    if (code >= 0xD800 && code <= 0xDBFF && i + 2 < view.length &&
+                        view.data[i + 1] == '\\' && view.data[i + 2] == 'u') {
+                        long low = read_hex4(view, i + 3);
+                        if (low >= 0xDC00 && low <= 0xDFFF) {
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                            i += 6;
+                        }
+                    }
+                    if (code >= 0xD800 && code <= 0xDFFF) code = 0xFFFD;  // Lone surrogate
+                    n = encode_utf8((unsigned long)code, decoded);
+                    break;
+                }
+                default:
+                    decoded[0] = c;  // \" \\ \/
+                    break;
+            }
+        }
+        
+        if (out + n >= size) break;
+        memcpy(dest + out, decoded, n);
+        out += n;
     }
     
-    // Add headers
-    wchar_t wszHeaders[1024];
-    swprintf(wszHeaders, sizeof(wszHeaders)/sizeof(wchar_t), 
-             L"Authorization: Bearer %hs\r\n"
-             L"User-Agent: GReleaseMon-c/1.0\r\n"
-             L"Accept: application/vnd.github.v3+json\r\n",
-             auth_token);
-    
-    // Send request
-    bResults = WinHttpSendRequest(hRequest, wszHeaders, -1, 
-                                 WINHTTP_NO_REQUEST_DATA, 0, 0, 0);
-    
-    if (!bResults) {
-        fprintf(stderr, "Error: Failed to send HTTP request for %s/%s\n", 
-                repo->owner, repo->repo);
-        goto cleanup;
+    dest[out] = '\0';
+    return out;
+}
+
+// Unescaped copy of a view for display; the caller frees it
+char* unescape_json_alloc(StringView view) {
+    char* text = malloc((size_t)view.length + 1);
+    if (text) unescape_json(view, text, (size_t)view.length + 1);
+    return text;
+}
+
+// Intern the unescaped text of a short field such as a tag name. Tags
+// repeat across repositories ("v1.0.0"), and an id is all a row needs.
+int intern_json_string(StringView view) {
+    char text[MAX_TAG_LENGTH];
+    unescape_json(view, text, sizeof(text));
+    return intern_string(text);
+}
+
+// Placeholder row for repositories without any release
+static void add_placeholder_release(const RepoInfo* repo, ReleaseQueue* results) {
+    Release release = {0};
+    release.owner = repo->owner_id;
+    release.repo = repo->repo_id;
+    release.tag = intern_string("None");
+    release.flags = RELEASE_PLACEHOLDER;
+    // Leave other fields blank
+    
+    publish_release(results, &release);
+}
+
+// Read a fixed-width run of decimal digits; -1 if any character is not a digit
+static int read_digits(const char* text, int count) {
+    int value = 0;
+    for (int i = 0; i < count; i++) {
+        unsigned int digit = (unsigned char)text[i] - '0';
+        if (digit > 9) return -1;
+        value = value * 10 + (int)digit;
+    }
+    return value;
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date (Howard Hinnant's
+// days_from_civil). Years are shifted to start in March so the leap day is last.
+static long long days_from_civil(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int year_of_era = year - era * 400;
+    int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return (long long)era * 146097 + day_of_era - 719468;
+}
+
+// Parse GitHub's fixed-format UTC timestamp, YYYY-MM-DDTHH:MM:SSZ, without
+// sscanf or the C library's time conversions. Returns 0 for malformed input,
+// which the UI already treats as an unknown date.
+time_t parse_timestamp(const char* text) {
+    static const int month_days[12] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    
+    if (strlen(text) < 20 || text[4] != '-' || text[7] != '-' || text[10] != 'T' ||
+        text[13] != ':' || text[16] != ':' || text[19] != 'Z') {
+        return 0;
     }
     
-    // Receive response
-    bResults = WinHttpReceiveResponse(hRequest, NULL);
+    int year = read_digits(text, 4);
+    int month = read_digits(text + 5, 2);
+    int day = read_digits(text + 8, 2);
+    int hour = read_digits(text + 11, 2);
+    int minute = read_digits(text + 14, 2);
+    int second = read_digits(text + 17, 2);
     
-    if (!bResults) {
-        fprintf(stderr, "Error: Failed to receive HTTP response for %s/%s\n", 
-                repo->owner, repo->repo);
-        goto cleanup;
+    if (year < 0 || month < 1 || month > 12 || day < 1 || day > month_days[month - 1] ||
+        hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 60) {
+        return 0;
     }
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (month == 2 && day == 29 && !leap) return 0;
     
-    // Check status code
-    WinHttpQueryHeaders(hRequest, WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
-                       WINHTTP_HEADER_NAME_BY_INDEX, &dwStatusCode, &dwStatusCodeSize, 
-                       WINHTTP_NO_HEADER_INDEX);
-    
-    if (dwStatusCode == 404) { // Not Found
-        // Repo has no releases, create a placeholder
-        Release release = {0};
-        strncpy(release.owner, repo->owner, MAX_REPO_NAME_LENGTH - 1);
-        strncpy(release.repo, repo->repo, MAX_REPO_NAME_LENGTH - 1);
-        strncpy(release.tag_name, "None", MAX_TAG_LENGTH - 1);
-        // Leave other fields blank
-        
-        add_release_to_collection(collection, &release);
-        goto cleanup;
+    return (time_t)(days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second);
+}
+
+// Fill a Release from the release object at token index object. Each
+// top-level field is visited once; nested objects such as author are
+// stepped over whole, so their html_url or name never shadow the release's.
+static void parse_release_tokens(const RepoInfo* repo, const char* json, const JsonDocument* doc,
+                                 int object, Release* release) {
+    memset(release, 0, sizeof(Release));
+    release->owner = repo->owner_id;
+    release->repo = repo->repo_id;
+    release->tag = -1;
+    
+    StringView url = make_string_view("");
+    StringView body = make_string_view(NO_RELEASE_NOTES);
+    
+    const JsonToken* tokens = doc->tokens;
+    for (int k = object + 1; k + 1 < tokens[object].next; k = tokens[k + 1].next) {
+        const JsonToken* key = &tokens[k];
+        const JsonToken* value = &tokens[k + 1];
+        StringView value_view = { json + value->start, value->end - value->start };
         
-    } else if (dwStatusCode != 200) {
-        fprintf(stderr, "Error: HTTP %lu for %s/%s\n", 
-                dwStatusCode, repo->owner, repo->repo);
-        goto cleanup;
+        if (json_token_equals(json, key, "tag_name") && value->type == JSON_STRING) {
+            release->tag = intern_json_string(value_view);
+        } else if (json_token_equals(json, key, "html_url") && value->type == JSON_STRING) {
+            url = value_view;
+        } else if (json_token_equals(json, key, "body") && value->type == JSON_STRING) {
+            body = value_view;
+        } else if (json_token_equals(json, key, "prerelease")) {
+            if (value->type == JSON_PRIMITIVE && json[value->start] == 't') release->flags |= RELEASE_PRERELEASE;
+        } else if (json_token_equals(json, key, "created_at") && value->type == JSON_STRING) {
+            char created_at[32];
+            json_token_copy(json, value, created_at, sizeof(created_at));
+            release->created_at = parse_timestamp(created_at);
+        } else if (json_token_equals(json, key, "assets")) {
+            release->platforms = classify_asset_tokens(json, doc, k + 1);
+        }
     }
     
-    // Read response data
-    char* response_data = NULL;
-    DWORD total_size = 0;
+    // The views above point into the response, which is about to go away
+    set_release_text(release, url, body);
+}
+
+// Fill a Release from one release object using the REST field names
+void parse_release_json(const RepoInfo* repo, const char* json, Release* release) {
+    JsonDocument doc = {0};
     
-    do {
-        dwSize = 0;
-        if (!WinHttpQueryDataAvailable(hRequest, &dwSize)) {
-            fprintf(stderr, "Error: Failed to query data available\n");
-            goto cleanup;
-        }
-        
-        if (dwSize == 0) break;
-        
-        response_data = realloc(response_data, total_size + dwSize + 1);
-        if (!response_data) {
-            fprintf(stderr, "Error: Out of memory\n");
-            goto cleanup;
-        }
-        
-        if (!WinHttpReadData(hRequest, response_data + total_size, dwSize, &dwDownloaded)) {
-            fprintf(stderr, "Error: Failed to read data\n");
-            free(response_data);
-            goto cleanup;
-        }
-        
-        total_size += dwDownloaded;
-    } while (dwSize > 0);
+    if (json_parse(json, strlen(json), &doc) && doc.tokens[0].type == JSON_OBJECT) {
+        parse_release_tokens(repo, json, &doc, 0, release);
+    } else {
+        // Unparseable body: keep the row, like a release without any fields
+        memset(release, 0, sizeof(Release));
+        release->owner = repo->owner_id;
+        release->repo = repo->repo_id;
+        release->tag = -1;
+        set_release_text(release, make_string_view(""), make_string_view(NO_RELEASE_NOTES));
+    }
     
-    if (response_data) {
-        response_data[total_size] = '\0';
-        
-        // Parse JSON response using simple string functions
-        Release release = {0};
-        
-        // Copy repo info
-        strncpy(release.owner, repo->owner, MAX_REPO_NAME_LENGTH - 1);
-        strncpy(release.repo, repo->repo, MAX_REPO_NAME_LENGTH - 1);
-        
-        // Parse tag name
-        char* tag_name = extract_json_string(response_data, "tag_name");
-        if (tag_name) {
-            strncpy(release.tag_name, tag_name, MAX_TAG_LENGTH - 1);
-            free(tag_name);
-        }
-        
-        // Parse URL
-        char* html_url = extract_json_string(response_data, "html_url");
-        if (html_url) {
-            strncpy(release.url, html_url, MAX_URL_LENGTH - 1);
-            free(html_url);
-        }
-        
-        // Parse body
-        char* body = extract_json_string(response_data, "body");
-        if (body) {
-            release.body = body;
+    free_json_document(&doc);
+}
+
+// Turn a finished /releases/latest response into a Release for the UI.
+// release is what the streaming parser built from a 200 body (NULL otherwise);
+// its text is handed over with it. A 304 reuses the cached release,
+// and a 200 with validators refreshes the cache entry.
+void process_release_response(const RepoInfo* repo, int status_code, Release* release,
+                              const CacheValidators* validators, ReleaseQueue* results) {
+    if (status_code == 304) { // Not Modified
+        Release cached;
+        if (release_cache_lookup(repo, &cached)) {
+            if (!publish_release(results, &cached)) {
+                free_release_text(&cached);
+            }
         } else {
-            release.body = strdup("No release notes available.");
-        }
-        
-        // Parse prerelease flag
-        release.prerelease = extract_json_bool(response_data, "prerelease");
-        
-        // Check for Windows assets
-        release.has_windows_assets = check_windows_assets(response_data);
-        
-        // Parse created_at
-        char* created_at = extract_json_string(response_data, "created_at");
-        if (created_at) {
-            struct tm tm = {0};
-            // Parse ISO 8601 date
-            sscanf(created_at, "%d-%d-%dT%d:%d:%d",
-                   &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
-                   &tm.tm_hour, &tm.tm_min, &tm.tm_sec);
-            tm.tm_year -= 1900;
-            tm.tm_mon -= 1;
-            // Use timegm to treat parsed time as UTC, not local time
-            #ifdef _WIN32
-            // Windows does not have timegm, so use _mkgmtime
-            release.created_at = _mkgmtime(&tm);
-            #else
-            release.created_at = timegm(&tm);
-            #endif
-            free(created_at);
+            fprintf(stderr, "Error: HTTP 304 without a cached release for %s/%s\n",
+                    repo->owner, repo->repo);
         }
+        return;
         
-        calculate_time_diff(&release);
-        add_release_to_collection(collection, &release);
+    } else if (status_code == 404) { // Not Found
+        // Repo has no releases, create a placeholder
+        add_placeholder_release(repo, results);
+        return;
         
-        free(response_data);
+    } else if (status_code != 200) {
+        fprintf(stderr, "Error: HTTP %d for %s/%s\n", 
+                status_code, repo->owner, repo->repo);
+        return;
     }
     
-cleanup:
-    if (hRequest) WinHttpCloseHandle(hRequest);
-    if (hConnect) WinHttpCloseHandle(hConnect);
-    if (hSession) WinHttpCloseHandle(hSession);
-}
-
-unsigned __stdcall fetch_release_thread(void* arg) {
-    FetchThreadData* data = (FetchThreadData*)arg;
-    fetch_latest_release(&data->repo, data->collection, data->auth_token);
-    return 0;
+    if (release) {
+        if (validators) {
+            release_cache_store(repo, validators, release);
+        }
+        if (!publish_release(results, release)) {
+            free_release_text(release);
+        }
+    }
 }
 
-int compare_releases_by_date(const void* a, const void* b) {
-    const Release* release_a = (const Release*)a;
-    const Release* release_b = (const Release*)b;
+// Build the POST body for one aliased GraphQL query covering every repo in
+// the batch. Fields are aliased to their REST names so each latestRelease
+// object parses exactly like a REST release. Caller frees the result.
+char* build_graphql_batch_query(const RepoInfo* repos, int count) {
+    size_t capacity = 64 + (size_t)count * (2 * MAX_REPO_NAME_LENGTH + sizeof(GRAPHQL_RELEASE_FIELDS) + 64);
+    char* query = malloc(capacity);
+    if (!query) return NULL;
+    
+    int written = snprintf(query, capacity, "{\"query\":\"query{");
+    size_t len = written > 0 ? (size_t)written : 0;
+    for (int i = 0; i < count && written >= 0 && len < capacity; i++) {
+        written = snprintf(query + len, capacity - len,
+                           "r%d:repository(owner:\\\"%s\\\",name:\\\"%s\\\"){latestRelease{"
+                           GRAPHQL_RELEASE_FIELDS "}}",
+                           i, repos[i].owner, repos[i].repo);
+        if (written >= 0) len += written;
+    }
+    if (written >= 0 && len < capacity) {
+        written = snprintf(query + len, capacity - len, "}\"}");
+        if (written >= 0) len += written;
+    }
     
-    // Sort in descending order (newest first)
-    if (release_a->created_at > release_b->created_at) return -1;
-    if (release_a->created_at < release_b->created_at) return 1;
-    return 0;
+    // A cut query is invalid JSON; fail the batch rather than send it
+    if (written < 0 || len >= capacity) {
+        fprintf(stderr, "Error: GraphQL query for the batch starting at %s/%s does not fit\n", repos[0].owner, repos[0].repo);
+        free(query);
+        return NULL;
+    }
+    return query;
 }
 
-void sort_releases_by_date(ReleaseCollection* collection) {
-    EnterCriticalSection(&collection->mutex);
+// Split a batched GraphQL response into one Release per repository.
+// Repositories that are missing or have no release get a placeholder row.
+void process_graphql_batch_response(const RepoInfo* repos, int count, int status_code,
+                                    const char* response_data, ReleaseQueue* results) {
+    if (status_code != 200 || !response_data) {
+        fprintf(stderr, "Error: HTTP %d for GraphQL batch of %d repos starting at %s/%s\n",
+                status_code, count, repos[0].owner, repos[0].repo);
+        return;
+    }
     
-    if (collection->count > 1) {
-        qsort(collection->releases, collection->count, sizeof(Release), 
-              compare_releases_by_date);
+    JsonDocument doc = {0};
+    if (!json_parse(response_data, strlen(response_data), &doc)) {
+        fprintf(stderr, "Error: Malformed GraphQL response for batch starting at %s/%s\n",
+                repos[0].owner, repos[0].repo);
+        free_json_document(&doc);
+        return;
+    }
+    
+    bool* answered = calloc(count, sizeof(bool));
+    int data = json_object_get(response_data, &doc, 0, "data");
+    
+    // Walk the aliases once; rN is the N-th repository of the batch
+    if (answered && data >= 0 && doc.tokens[data].type == JSON_OBJECT) {
+        const JsonToken* tokens = doc.tokens;
+        for (int k = data + 1; k + 1 < tokens[data].next; k = tokens[k + 1].next) {
+            const JsonToken* key = &tokens[k];
+            if (key->type != JSON_STRING || response_data[key->start] != 'r') continue;
+            
+            int i = atoi(response_data + key->start + 1);
+            if (i < 0 || i >= count || answered[i]) continue;
+            answered[i] = true;
+            
+            int latest = json_object_get(response_data, &doc, k + 1, "latestRelease");
+            if (latest < 0 || tokens[latest].type != JSON_OBJECT) {
+                add_placeholder_release(&repos[i], results);
+            } else {
+                Release release;
+                parse_release_tokens(&repos[i], response_data, &doc, latest, &release);
+                if (!publish_release(results, &release)) {
+                    free_release_text(&release);
+                }
+            }
+        }
+    }
+    
+    for (int i = 0; i < count; i++) {
+        if (!answered || !answered[i]) {
+            fprintf(stderr, "Error: No GraphQL result for %s/%s\n", repos[i].owner, repos[i].repo);
+        }
     }
     
-    LeaveCriticalSection(&collection->mutex);
+    free(answered);
+    free_json_document(&doc);
 }
\ No newline at end of file
@@ -1,64 +1,171 @@
-#ifdef _WIN32
-#include <time.h>
-#ifndef _mkgmtime
-// Provide prototype for _mkgmtime if not included
-time_t _mkgmtime(struct tm *tm);
-#endif
-#else
-#include <time.h>
-#endif
 #ifndef REQUESTS_H
 #define REQUESTS_H
 
 #include <time.h>
 #include <stdbool.h>
-#include <Windows.h>
+#include "platform.h"
 #include "config.h"
 
-#define MAX_URL_LENGTH 512
+#define MAX_TIME_DIFF_LENGTH 64  // Buffer size for format_release_age
+#define MAX_VALIDATOR_LENGTH 128
 #define MAX_TAG_LENGTH 128
-#define MAX_TIME_DIFF_LENGTH 64
+#define GRAPHQL_BATCH_SIZE 50
+#define RELEASE_BLOCK_SIZE 256
+#define NO_RELEASE_NOTES "No release notes available."
+
+// Release fields requested per repository, aliased to their REST names
+#define GRAPHQL_RELEASE_FIELDS "tag_name:tagName html_url:url body:description " \
+                               "prerelease:isPrerelease created_at:createdAt " \
+                               "assets:releaseAssets(first:100){nodes{name}}"
+
+// Pointer and length into text owned elsewhere; not NUL-terminated and
+// still JSON-escaped until unescape_json is called for display
+typedef struct {
+    const char* data;
+    int length;
+} StringView;
+
+#define RELEASE_PRERELEASE  0x01
+#define RELEASE_PLACEHOLDER 0x02    // Repository without any release
+
+// Cold part of a release, only read when its page is opened or it is
+// cached. One allocation holds the views and the strings behind them.
+typedef struct {
+    StringView url;
+    StringView body;
+    char text[];          // URL and body, each NUL-terminated
+} ReleaseDetails;
 
+// Hot part: what the table scans, sorts and filters on
 typedef struct {
-    char owner[MAX_REPO_NAME_LENGTH];
-    char repo[MAX_REPO_NAME_LENGTH];
-    char tag_name[MAX_TAG_LENGTH];
-    char url[MAX_URL_LENGTH];
-    char* body;  // Dynamically allocated
-    bool prerelease;
     time_t created_at;
-    char time_difference[MAX_TIME_DIFF_LENGTH];
-    bool has_windows_assets;
+    ReleaseDetails* details;  // NULL for placeholders
+    int owner;                // Interned, see string_table.h
+    int repo;
+    int tag;                  // Interned and already unescaped
+    unsigned char flags;      // RELEASE_* bits
+    unsigned char platforms;  // ASSET_* bits of the release's asset names
 } Release;
 
+// HTTP cache validators (ETag / Last-Modified) returned with a release
+typedef struct {
+    char etag[MAX_VALIDATOR_LENGTH];
+    char last_modified[MAX_VALIDATOR_LENGTH];
+} CacheValidators;
+
+// DOM-lite JSON: a flat token array built in one pass over the document
+typedef enum {
+    JSON_OBJECT,
+    JSON_ARRAY,
+    JSON_STRING,
+    JSON_PRIMITIVE      // Number, true, false or null
+} JsonType;
+
 typedef struct {
-    Release* releases;
+    JsonType type;
+    int start;          // Byte offsets into the document; strings exclude the quotes
+    int end;
+    int parent;         // Enclosing container, -1 for the root
+    int depth;
+    int next;           // First token after this value's subtree
+} JsonToken;
+
+typedef struct {
+    JsonToken* tokens;
     int count;
     int capacity;
-    CRITICAL_SECTION mutex;
-} ReleaseCollection;
+} JsonDocument;
 
+// Columns the table can be sorted by, in column order
+typedef enum {
+    SORT_BY_REPO,
+    SORT_BY_TAG,
+    SORT_BY_AGE,
+    SORT_BY_TYPE,           // Prereleases apart from releases
+    SORT_BY_PLATFORMS,
+    SORT_FIELD_COUNT
+} SortField;
+
+#define SORT_ORDER_COUNT (2 * SORT_FIELD_COUNT)    // Ascending and descending
+
+// Facets: record properties the table can be narrowed to
+#define FACET_PRERELEASE 0x01
+#define FACET_WINDOWS    0x02
+#define FACET_RECENT     0x04   // Created in the last FACET_RECENT_DAYS
+#define FACET_COUNT      3
+#define FACET_RECENT_DAYS 7
+
+// Sort key of one release in one order
+typedef struct {
+    unsigned long long key; // Primary key; for names and tags their first bytes
+    int id;                 // Record number, see get_release
+} ReleaseKey;
+
+// Every record in one sort order. Built the first time the order is used,
+// then kept current by merging in new records, see release_sort.h.
+typedef struct {
+    ReleaseKey* keys;
+    int count;              // Records merged in so far
+    int capacity;
+} ReleaseOrder;
+
+typedef struct SearchIndex SearchIndex;
+
+// Releases shown in the table. Owned by the UI thread, so it has no lock;
+// fetch threads hand their results over through a ReleaseQueue.
+// Records live in fixed-size blocks and never move once added. The record
+// number (ReleaseKey.id) is the handle to hold on to: it stays valid for
+// the collection's lifetime, whatever happens to the table order. Only the
+// compact keys of each order are moved to keep the table sorted.
 typedef struct {
-    RepoInfo repo;
-    ReleaseCollection* collection;
-    const char* auth_token;
-} FetchThreadData;
+    Release** blocks;       // RELEASE_BLOCK_SIZE records each
+    int block_count;
+    int count;
+    ReleaseOrder orders[SORT_ORDER_COUNT];  // By field * 2 + descending
+    ReleaseOrder* order;    // The one shown; newest first to begin with
+    int* rows;              // Record number -> row in order
+    int row_capacity;
+    unsigned long long* facets[FACET_COUNT];  // Bit per record
+    int facet_words;
+    time_t recent_since;    // Cutoff the FACET_RECENT bits were computed for
+    SearchIndex* search;    // Trigrams of every record, see release_search.h
+} ReleaseCollection;
+
+typedef struct ReleaseQueue ReleaseQueue;
 
 // Function declarations
 ReleaseCollection* create_release_collection(int initial_capacity);
 void free_release_collection(ReleaseCollection* collection);
-void fetch_latest_release(RepoInfo* repo, ReleaseCollection* collection, const char* auth_token);
-unsigned __stdcall fetch_release_thread(void* arg);
-void calculate_time_diff(Release* release);
+void parse_release_json(const RepoInfo* repo, const char* json, Release* release);
+void process_release_response(const RepoInfo* repo, int status_code, Release* release,
+                              const CacheValidators* validators, ReleaseQueue* results);
+char* build_graphql_batch_query(const RepoInfo* repos, int count);
+void process_graphql_batch_response(const RepoInfo* repos, int count, int status_code,
+                                    const char* response_data, ReleaseQueue* results);
+void format_release_age(time_t created_at, char* buf, size_t size);
+time_t next_age_change(time_t created_at, time_t now);
+time_t parse_timestamp(const char* text);
 bool add_release_to_collection(ReleaseCollection* collection, Release* release);
-void sort_releases_by_date(ReleaseCollection* collection);
+bool set_release_text(Release* release, StringView url, StringView body);
+bool copy_release(Release* dest, const Release* src);
+void free_release_text(Release* release);
+StringView get_release_url(const Release* release);
+StringView get_release_body(const Release* release);
+Release* get_release(const ReleaseCollection* collection, int id);
+Release* get_release_at(const ReleaseCollection* collection, int row);
 
-// JSON parsing functions
-char* extract_json_string(const char* json, const char* key);
-bool extract_json_bool(const char* json, const char* key);
+// String views
+StringView make_string_view(const char* text);
+bool string_view_equals(StringView view, const char* text);
+size_t unescape_json(StringView view, char* dest, size_t size);
+char* unescape_json_alloc(StringView view);
+int intern_json_string(StringView view);
 
-// Windows assets detection
-bool is_windows_asset(const char* name);
-bool check_windows_assets(const char* json);
+// JSON parsing functions
+bool json_parse(const char* json, size_t len, JsonDocument* doc);
+void free_json_document(JsonDocument* doc);
+bool json_token_equals(const char* json, const JsonToken* token, const char* text);
+void json_token_copy(const char* json, const JsonToken* token, char* dest, size_t size);
+int json_object_get(const char* json, const JsonDocument* doc, int object, const char* key);
 
 #endif // REQUESTS_H
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Central request scheduler. The quota GitHub reports in X-RateLimit-Remaining
+// is the token bucket: every dispatch takes a token, every response refills
+// the bucket from the server's count, and X-RateLimit-Reset refills it fully.
+typedef struct {
+    long limit;             // -1 until a response carried rate-limit headers
+    long tokens;            // Quota left according to the last response
+    time_t reset_at;
+    time_t blocked_until;
+    int outstanding;        // Dispatched, response not seen yet
+    int pending;            // Submitted and not finished
+    int retries;
+    int backoff;            // Next secondary-limit wait, in seconds
+    int completed;
+    time_t first_dispatch;
+} Scheduler;
+
+static Scheduler g_scheduler;
+static bool g_initialized = false;
+static CRITICAL_SECTION g_scheduler_mutex;
+
+void scheduler_init(void) {
+    if (g_initialized) return;
+
+    memset(&g_scheduler, 0, sizeof(g_scheduler));
+    g_scheduler.limit = -1;
+    g_scheduler.backoff = SCHEDULER_SECONDARY_BACKOFF;
+    InitializeCriticalSection(&g_scheduler_mutex);
+    g_initialized = true;
+}
+
+void scheduler_cleanup(void) {
+    if (!g_initialized) return;
+
+    DeleteCriticalSection(&g_scheduler_mutex);
+    g_initialized = false;
+}
+
+void init_rate_limit_headers(RateLimitHeaders* headers) {
+    headers->limit = -1;
+    headers->remaining = -1;
+    headers->reset = -1;
+    headers->retry_after = -1;
+}
+
+void scheduler_add_pending(int count) {
+    if (!g_initialized) return;
+
+    EnterCriticalSection(&g_scheduler_mutex);
+    g_scheduler.pending += count;
+    LeaveCriticalSection(&g_scheduler_mutex);
+}
+
+// Take a token for one request. When none is available, report how long the
+// caller should wait before asking again.
+bool scheduler_acquire(long long* wait_ms) {
+    if (!g_initialized) return true;
+
+    time_t now = time(NULL);
+    bool allowed = true;
+    time_t wait_until = 0;
+
+    EnterCriticalSection(&g_scheduler_mutex);
+    Scheduler* s = &g_scheduler;
+
+    if (s->limit >= 0 && s->reset_at > 0 && now >= s->reset_at) {
+        // The window rolled over; assume a full bucket until told otherwise
+        s->tokens = s->limit;
+        s->reset_at = 0;
+    }
+
+    if (s->blocked_until > now) {
+        allowed = false;
+        wait_until = s->blocked_until;
+    } else if (s->limit >= 0 && s->tokens - s->outstanding <= SCHEDULER_RESERVE) {
+        allowed = false;
+        // Without a reset time, poll again once in-flight responses update the count
+        wait_until = s->reset_at > now ? s->reset_at : now + 1;
+    }
+
+    if (allowed) {
+        s->outstanding++;
+        if (s->first_dispatch == 0) s->first_dispatch = now;
+    }
+    LeaveCriticalSection(&g_scheduler_mutex);
+
+    if (wait_ms) *wait_ms = allowed ? 0 : (long long)(wait_until - now) * 1000;
+    return allowed;
+}
+
+static bool is_rate_limited(int status_code, const RateLimitHeaders* headers, const char* body) {
+    if (status_code == 429) return true;
+    if (status_code != 403) return false;
+
+    // A 403 is also returned for plain permission problems; only retry when
+    // GitHub says it was throttling us
+    if (headers->retry_after >= 0 || headers->remaining == 0) return true;
+    return body && strstr(body, "rate limit") != NULL;
+}
+
+// Account for a response. Returns true when the request was throttled and
+// should be queued again instead of completing.
+bool scheduler_on_response(int status_code, const RateLimitHeaders* headers, const char* body) {
+    if (!g_initialized) return false;
+
+    time_t now = time(NULL);
+    bool limited = is_rate_limited(status_code, headers, body);
+
+    EnterCriticalSection(&g_scheduler_mutex);
+    Scheduler* s = &g_scheduler;
+
+    if (s->outstanding > 0) s->outstanding--;
+
+    if (headers->remaining >= 0) {
+        // Responses can arrive out of order; within one window the lowest count is the newest
+        bool same_window = s->limit >= 0 &&
+                           (headers->reset < 0 || (time_t)headers->reset == s->reset_at);
+        if (!same_window || headers->remaining < s->tokens) s->tokens = headers->remaining;
+        if (s->limit < 0) s->limit = headers->remaining;
+    }
+    if (headers->limit >= 0) s->limit = headers->limit;
+    if (headers->reset >= 0) s->reset_at = (time_t)headers->reset;
+
+    if (limited) {
+        time_t until;
+        if (headers->retry_after >= 0) {
+            until = now + headers->retry_after;
+        } else if (headers->remaining == 0 && headers->reset > 0) {
+            until = (time_t)headers->reset;
+        } else {
+            // Secondary limit without a hint: back off exponentially
+            until = now + s->backoff;
+            s->backoff *= 2;
+            if (s->backoff > SCHEDULER_MAX_BACKOFF) s->backoff = SCHEDULER_MAX_BACKOFF;
+        }
+        if (until > s->blocked_until) s->blocked_until = until;
+        s->retries++;
+    } else if (status_code > 0 && status_code < 400) {
+        s->backoff = SCHEDULER_SECONDARY_BACKOFF;
+    }
+    LeaveCriticalSection(&g_scheduler_mutex);
+
+    return limited;
+}
+
+// A request is done for good. awaiting_response is set when it was
+// dispatched but never produced a response (connection failure, shutdown).
+void scheduler_on_finished(bool awaiting_response) {
+    if (!g_initialized) return;
+
+    EnterCriticalSection(&g_scheduler_mutex);
+    if (awaiting_response && g_scheduler.outstanding > 0) g_scheduler.outstanding--;
+    if (g_scheduler.pending > 0) g_scheduler.pending--;
+    g_scheduler.completed++;
+    LeaveCriticalSection(&g_scheduler_mutex);
+}
+
+// Extrapolate from the throughput so far, pushing whatever does not fit in
+// the remaining quota past the reset of each window
+static time_t project_completion(const Scheduler* s, time_t now) {
+    if (s->pending == 0 || s->completed == 0 || s->first_dispatch == 0) return 0;
+
+    double elapsed = (double)(now - s->first_dispatch);
+    if (elapsed < 1.0) elapsed = 1.0;
+    double rate = s->completed / elapsed;
+
+    time_t start = s->blocked_until > now ? s->blocked_until : now;
+    long available = s->tokens - s->outstanding - SCHEDULER_RESERVE;
+    if (available < 0) available = 0;
+
+    if (s->limit <= SCHEDULER_RESERVE || s->pending <= available) {
+        return start + (time_t)(s->pending / rate);
+    }
+
+    long overflow = s->pending - available;
+    long per_window = s->limit - SCHEDULER_RESERVE;
+    long windows = (overflow - 1) / per_window;
+    time_t reset = s->reset_at > start ? s->reset_at : start;
+
+    return reset + (time_t)windows * SCHEDULER_WINDOW_SECONDS +
+           (time_t)((overflow - windows * per_window) / rate);
+}
+
+void scheduler_get_status(SchedulerStatus* status) {
+    memset(status, 0, sizeof(SchedulerStatus));
+    status->limit = -1;
+    if (!g_initialized) return;
+
+    time_t now = time(NULL);
+
+    EnterCriticalSection(&g_scheduler_mutex);
+    status->limit = g_scheduler.limit;
+    status->remaining = g_scheduler.tokens;
+    status->reset_at = g_scheduler.reset_at;
+    status->blocked_until = g_scheduler.blocked_until > now ? g_scheduler.blocked_until : 0;
+    status->pending = g_scheduler.pending;
+    status->retries = g_scheduler.retries;
+    status->projected_completion = project_completion(&g_scheduler, now);
+    LeaveCriticalSection(&g_scheduler_mutex);
+}
@@ -0,0 +1,42 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+#include <time.h>
+#include "platform.h"
+
+#define SCHEDULER_RESERVE 5              // Quota left untouched for other tools
+#define SCHEDULER_MAX_RETRIES 5
+#define SCHEDULER_SECONDARY_BACKOFF 60   // First wait after a secondary limit, in seconds
+#define SCHEDULER_MAX_BACKOFF 900
+#define SCHEDULER_WINDOW_SECONDS 3600    // Length of GitHub's primary rate-limit window
+
+// Rate-limit headers of one response; -1 marks an absent header
+typedef struct {
+    long limit;
+    long remaining;
+    long long reset;      // X-RateLimit-Reset, epoch seconds
+    long retry_after;     // Retry-After, seconds
+} RateLimitHeaders;
+
+typedef struct {
+    long limit;                 // -1 until the first response
+    long remaining;
+    time_t reset_at;
+    time_t blocked_until;       // Dispatch is paused until then (0 = not blocked)
+    int pending;                // Requests queued or in flight
+    int retries;                // Requests re-queued after a rate-limit response
+    time_t projected_completion;  // 0 when unknown
+} SchedulerStatus;
+
+// Function declarations
+void scheduler_init(void);
+void scheduler_cleanup(void);
+void init_rate_limit_headers(RateLimitHeaders* headers);
+void scheduler_add_pending(int count);
+bool scheduler_acquire(long long* wait_ms);
+bool scheduler_on_response(int status_code, const RateLimitHeaders* headers, const char* body);
+void scheduler_on_finished(bool awaiting_response);
+void scheduler_get_status(SchedulerStatus* status);
+
+#endif // SCHEDULER_H
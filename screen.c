@@ -0,0 +1,293 @@
+#include "screen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCREEN_STREAM_INITIAL_SIZE 4096
+
+struct Screen {
+    int width;
+    int height;
+    ScreenCell* back;       // Being drawn
+    ScreenCell* front;      // On the console
+    unsigned char* dirty;   // Rows of back written since the last flush
+#ifdef _WIN32
+    HANDLE output;
+    CHAR_INFO* run;         // One row of cells for WriteConsoleOutput
+#else
+    char* stream;           // Escape sequences and text of one frame
+    size_t stream_length;
+    size_t stream_capacity;
+#endif
+};
+
+Screen* create_screen(int width, int height, WORD attr) {
+    if (width < 1 || height < 1) return NULL;
+
+    Screen* screen = calloc(1, sizeof(Screen));
+    if (!screen) return NULL;
+
+    screen->width = width;
+    screen->height = height;
+    screen->back = malloc((size_t)width * height * sizeof(ScreenCell));
+    screen->front = malloc((size_t)width * height * sizeof(ScreenCell));
+    screen->dirty = calloc(height, 1);
+#ifdef _WIN32
+    screen->output = GetStdHandle(STD_OUTPUT_HANDLE);
+    screen->run = malloc(width * sizeof(CHAR_INFO));
+    if (!screen->run) {
+        free_screen(screen);
+        return NULL;
+    }
+#endif
+    if (!screen->back || !screen->front || !screen->dirty) {
+        free_screen(screen);
+        return NULL;
+    }
+
+    // Both buffers start out as the freshly cleared console
+    for (int i = 0; i < width * height; i++) {
+        screen->back[i].ch = ' ';
+        screen->back[i].attr = attr;
+        screen->front[i] = screen->back[i];
+    }
+    return screen;
+}
+
+void free_screen(Screen* screen) {
+    if (!screen) return;
+
+    free(screen->back);
+    free(screen->front);
+    free(screen->dirty);
+#ifdef _WIN32
+    free(screen->run);
+#else
+    free(screen->stream);
+#endif
+    free(screen);
+}
+
+// Next code point of UTF-8 text. Malformed bytes come out as '?' one at a
+// time and control characters as spaces, so each takes exactly one cell.
+static unsigned int next_code_point(const char** text) {
+    const unsigned char* p = (const unsigned char*)*text;
+    unsigned int c = *p;
+    int extra;
+
+    if (c < 0x80) {
+        *text += 1;
+        return (c < 32 || c == 127) ? ' ' : c;
+    } else if (c >= 0xC2 && c < 0xE0) {
+        extra = 1;
+        c &= 0x1F;
+    } else if (c >= 0xE0 && c < 0xF0) {
+        extra = 2;
+        c &= 0x0F;
+    } else if (c >= 0xF0 && c < 0xF5) {
+        extra = 3;
+        c &= 0x07;
+    } else {
+        *text += 1;
+        return '?';
+    }
+
+    for (int i = 1; i <= extra; i++) {
+        if ((p[i] & 0xC0) != 0x80) {
+            *text += 1;
+            return '?';
+        }
+        c = (c << 6) | (p[i] & 0x3F);
+    }
+    *text += 1 + extra;
+    return c;
+}
+
+// Write text into the back buffer from (x, y), clipped to the screen
+void screen_put(Screen* screen, int x, int y, const char* text, WORD attr) {
+    if (y < 0 || y >= screen->height) return;
+
+    ScreenCell* row = screen->back + (size_t)y * screen->width;
+    while (*text && x < screen->width) {
+        unsigned int ch = next_code_point(&text);
+        if (x >= 0) {
+            row[x].ch = ch;
+            row[x].attr = attr;
+        }
+        x++;
+    }
+    screen->dirty[y] = 1;
+}
+
+void screen_fill(Screen* screen, int x, int y, int count, char ch, WORD attr) {
+    if (y < 0 || y >= screen->height) return;
+    if (x < 0) {
+        count += x;
+        x = 0;
+    }
+    if (count > screen->width - x) count = screen->width - x;
+
+    ScreenCell* row = screen->back + (size_t)y * screen->width;
+    for (int i = 0; i < count; i++) {
+        row[x + i].ch = (unsigned char)ch;
+        row[x + i].attr = attr;
+    }
+    screen->dirty[y] = 1;
+}
+
+// Blank the whole back buffer; only cells that were not blank get sent
+void screen_clear(Screen* screen, WORD attr) {
+    for (int y = 0; y < screen->height; y++) {
+        screen_fill(screen, 0, y, screen->width, ' ', attr);
+    }
+}
+
+static bool same_cell(const ScreenCell* a, const ScreenCell* b) {
+    return a->ch == b->ch && a->attr == b->attr;
+}
+
+// End of the run of changes starting at x: it goes on across unchanged
+// stretches shorter than SCREEN_RUN_GAP
+static int find_run_end(const ScreenCell* back, const ScreenCell* front, int x, int width) {
+    int end = x + 1;
+    for (int i = x + 1; i < width && i - end < SCREEN_RUN_GAP; i++) {
+        if (!same_cell(&back[i], &front[i])) end = i + 1;
+    }
+    return end;
+}
+
+#ifdef _WIN32
+
+static bool write_run(Screen* screen, const ScreenCell* cells, int x, int y, int count) {
+    for (int i = 0; i < count; i++) {
+        screen->run[i].Char.UnicodeChar = (cells[i].ch <= 0xFFFF) ? (WCHAR)cells[i].ch : L'?';
+        screen->run[i].Attributes = cells[i].attr;
+    }
+
+    COORD size = { (SHORT)count, 1 };
+    COORD origin = { 0, 0 };
+    SMALL_RECT region = { (SHORT)x, (SHORT)y, (SHORT)(x + count - 1), (SHORT)y };
+    return WriteConsoleOutputW(screen->output, screen->run, size, origin, &region) != 0;
+}
+
+#else
+
+static bool append_stream(Screen* screen, const char* data, size_t length) {
+    if (screen->stream_length + length > screen->stream_capacity) {
+        size_t new_capacity = screen->stream_capacity ? screen->stream_capacity * 2 : SCREEN_STREAM_INITIAL_SIZE;
+        while (new_capacity < screen->stream_length + length) new_capacity *= 2;
+        char* new_stream = realloc(screen->stream, new_capacity);
+        if (!new_stream) return false;
+        screen->stream = new_stream;
+        screen->stream_capacity = new_capacity;
+    }
+    memcpy(screen->stream + screen->stream_length, data, length);
+    screen->stream_length += length;
+    return true;
+}
+
+// SGR sequence for console attribute bits. Win32 orders the color bits
+// blue, green, red; ANSI numbers them red, green, blue.
+static int format_attr(WORD attr, char* buffer, size_t size) {
+    int fg = ((attr & FOREGROUND_RED) ? 1 : 0) | ((attr & FOREGROUND_GREEN) ? 2 : 0) |
+             ((attr & FOREGROUND_BLUE) ? 4 : 0);
+    int bg = ((attr & BACKGROUND_RED) ? 1 : 0) | ((attr & BACKGROUND_GREEN) ? 2 : 0) |
+             ((attr & BACKGROUND_BLUE) ? 4 : 0);
+    return snprintf(buffer, size, "\x1b[0;%d;%dm",
+                    ((attr & FOREGROUND_INTENSITY) ? 90 : 30) + fg,
+                    ((attr & BACKGROUND_INTENSITY) ? 100 : 40) + bg);
+}
+
+static int encode_utf8(unsigned int ch, char* out) {
+    if (ch < 0x80) {
+        out[0] = (char)ch;
+        return 1;
+    } else if (ch < 0x800) {
+        out[0] = (char)(0xC0 | (ch >> 6));
+        out[1] = (char)(0x80 | (ch & 0x3F));
+        return 2;
+    } else if (ch < 0x10000) {
+        out[0] = (char)(0xE0 | (ch >> 12));
+        out[1] = (char)(0x80 | ((ch >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (ch & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (ch >> 18));
+    out[1] = (char)(0x80 | ((ch >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((ch >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (ch & 0x3F));
+    return 4;
+}
+
+// Cursor move, then the cells, switching attributes only where they change
+static bool write_run(Screen* screen, const ScreenCell* cells, int x, int y, int count, int* current_attr) {
+    char buffer[32];
+    int length = snprintf(buffer, sizeof(buffer), "\x1b[%d;%dH", y + 1, x + 1);
+    if (!append_stream(screen, buffer, length)) return false;
+
+    for (int i = 0; i < count; i++) {
+        if (cells[i].attr != *current_attr) {
+            length = format_attr(cells[i].attr, buffer, sizeof(buffer));
+            if (!append_stream(screen, buffer, length)) return false;
+            *current_attr = cells[i].attr;
+        }
+        length = encode_utf8(cells[i].ch, buffer);
+        if (!append_stream(screen, buffer, length)) return false;
+    }
+    return true;
+}
+
+#endif
+
+// Send the differences between back and front buffer to the console and
+// make them the new front. Cost follows the number of rows drawn into and
+// the cells that actually changed, not the size of the screen.
+bool flush_screen(Screen* screen) {
+    bool ok = true;
+#ifndef _WIN32
+    int current_attr = -1;  // Unknown at the start of a frame
+    screen->stream_length = 0;
+#endif
+
+    for (int y = 0; y < screen->height && ok; y++) {
+        if (!screen->dirty[y]) continue;
+
+        ScreenCell* back = screen->back + (size_t)y * screen->width;
+        ScreenCell* front = screen->front + (size_t)y * screen->width;
+        for (int x = 0; x < screen->width && ok; ) {
+            if (same_cell(&back[x], &front[x])) {
+                x++;
+                continue;
+            }
+            int end = find_run_end(back, front, x, screen->width);
+#ifdef _WIN32
+            ok = write_run(screen, back + x, x, y, end - x);
+#else
+            ok = write_run(screen, back + x, x, y, end - x, &current_attr);
+#endif
+            x = end;
+        }
+        if (ok) {
+            memcpy(front, back, screen->width * sizeof(ScreenCell));
+            screen->dirty[y] = 0;
+        }
+    }
+
+#ifndef _WIN32
+    if (ok && screen->stream_length > 0) {
+        ok = append_stream(screen, "\x1b[0m", 4);
+        size_t written = 0;
+        while (ok && written < screen->stream_length) {
+            ssize_t result = write(STDOUT_FILENO, screen->stream + written, screen->stream_length - written);
+            if (result <= 0) ok = false;
+            else written += result;
+        }
+    }
+    if (!ok) {
+        // The terminal may show any part of the frame: repaint all of it next time
+        for (int i = 0; i < screen->width * screen->height; i++) screen->front[i].ch = 0;
+        memset(screen->dirty, 1, screen->height);
+    }
+#endif
+    return ok;
+}
@@ -0,0 +1,29 @@
+#ifndef SCREEN_H
+#define SCREEN_H
+
+#include <stdbool.h>
+#include "platform.h"
+
+#define SCREEN_RUN_GAP 8    // Unchanged cells worth rewriting to avoid another write
+
+// In-memory model of the console. Drawing only writes cells of the back
+// buffer; flush_screen compares the rows written since the last frame
+// with the front buffer (what the console shows) and sends just the runs
+// of cells that differ. On Windows each run is one WriteConsoleOutput;
+// elsewhere the whole frame is one VT escape stream in a single write.
+typedef struct {
+    unsigned int ch;        // Unicode code point
+    WORD attr;              // FOREGROUND_* and BACKGROUND_* bits
+} ScreenCell;
+
+typedef struct Screen Screen;
+
+// Function declarations
+Screen* create_screen(int width, int height, WORD attr);
+void free_screen(Screen* screen);
+void screen_put(Screen* screen, int x, int y, const char* text, WORD attr);
+void screen_fill(Screen* screen, int x, int y, int count, char ch, WORD attr);
+void screen_clear(Screen* screen, WORD attr);
+bool flush_screen(Screen* screen);
+
+#endif // SCREEN_H
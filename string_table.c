@@ -0,0 +1,100 @@
+#include "string_table.h"
+#include "arena.h"
+#include "platform.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Chain link and text in one arena allocation, so interning a new
+// string costs a bump of the arena pointer rather than two mallocs
+typedef struct InternEntry {
+    struct InternEntry* next;
+    int id;
+    char text[];
+} InternEntry;
+
+// Interning takes the lock; lookups by id do not. Strings are only ever
+// appended and the directory pages never move, so an id handed out by
+// intern_string stays readable from any thread.
+static const char** g_pages[STRING_TABLE_MAX_PAGES];
+static int g_count = 0;
+static InternEntry* g_buckets[STRING_TABLE_BUCKET_COUNT];
+static Arena* g_arena = NULL;
+static bool g_initialized = false;
+static CRITICAL_SECTION g_table_mutex;
+
+bool string_table_init(void) {
+    if (g_initialized) return true;
+
+    g_arena = create_arena(STRING_TABLE_CHUNK_SIZE);
+    if (!g_arena) return false;
+
+    InitializeCriticalSection(&g_table_mutex);
+    g_initialized = true;
+    return true;
+}
+
+void string_table_cleanup(void) {
+    if (!g_initialized) return;
+
+    free_arena(g_arena);
+    g_arena = NULL;
+    memset(g_buckets, 0, sizeof(g_buckets));
+    for (int i = 0; i < STRING_TABLE_MAX_PAGES && g_pages[i]; i++) {
+        free(g_pages[i]);
+        g_pages[i] = NULL;
+    }
+    g_count = 0;
+
+    DeleteCriticalSection(&g_table_mutex);
+    g_initialized = false;
+}
+
+// FNV-1a
+static unsigned int hash_string(const char* text) {
+    unsigned int hash = 2166136261u;
+    while (*text) {
+        hash ^= (unsigned char)*text++;
+        hash *= 16777619u;
+    }
+    return hash % STRING_TABLE_BUCKET_COUNT;
+}
+
+// Id of text, adding it on first use. Returns -1 when out of memory.
+int intern_string(const char* text) {
+    if (!g_initialized) return -1;
+
+    unsigned int bucket = hash_string(text);
+    int id = -1;
+
+    EnterCriticalSection(&g_table_mutex);
+    for (InternEntry* entry = g_buckets[bucket]; entry; entry = entry->next) {
+        if (strcmp(entry->text, text) == 0) {
+            id = entry->id;
+            break;
+        }
+    }
+
+    if (id < 0 && g_count < STRING_TABLE_PAGE_SIZE * STRING_TABLE_MAX_PAGES) {
+        int page = g_count / STRING_TABLE_PAGE_SIZE;
+        if (!g_pages[page]) g_pages[page] = calloc(STRING_TABLE_PAGE_SIZE, sizeof(char*));
+
+        size_t len = strlen(text) + 1;
+        InternEntry* entry = g_pages[page] ? arena_alloc(g_arena, sizeof(InternEntry) + len) : NULL;
+        if (entry) {
+            memcpy(entry->text, text, len);
+            g_pages[page][g_count % STRING_TABLE_PAGE_SIZE] = entry->text;
+            entry->id = id = g_count++;
+            entry->next = g_buckets[bucket];
+            g_buckets[bucket] = entry;
+        }
+    }
+    LeaveCriticalSection(&g_table_mutex);
+
+    return id;
+}
+
+const char* get_interned_string(int id) {
+    if (id < 0) return "";
+    return g_pages[id / STRING_TABLE_PAGE_SIZE][id % STRING_TABLE_PAGE_SIZE];
+}
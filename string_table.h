@@ -0,0 +1,23 @@
+#ifndef STRING_TABLE_H
+#define STRING_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define STRING_TABLE_PAGE_SIZE 1024     // Ids per directory page
+#define STRING_TABLE_MAX_PAGES 1024
+#define STRING_TABLE_BUCKET_COUNT 4096
+#define STRING_TABLE_CHUNK_SIZE (16 * 1024)
+
+// Process-wide table of distinct strings. Each string gets a small integer
+// id the first time it is interned; the same text always maps to the same id.
+// The text lives in an arena until string_table_cleanup, so the pointer
+// returned by get_interned_string can be kept as long as the id.
+
+// Function declarations
+bool string_table_init(void);
+void string_table_cleanup(void);
+int intern_string(const char* text);
+const char* get_interned_string(int id);
+
+#endif // STRING_TABLE_H
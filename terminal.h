@@ -0,0 +1,49 @@
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include <stdbool.h>
+#include "platform.h"
+
+#define TERMINAL_DEFAULT_WIDTH  80     // When the size cannot be queried
+#define TERMINAL_DEFAULT_HEIGHT 24
+#define TERMINAL_ESCAPE_TIMEOUT_MS 25  // Longer than this after Esc: the key itself
+#define TERMINAL_WAIT_FOREVER -1
+
+// What ended a terminal_wait; 0 when the timeout ran out
+#define TERMINAL_EVENT_KEY  1
+#define TERMINAL_EVENT_WAKE 2
+
+// Key codes, as _getch reports them on Windows
+#define KEY_UP      72
+#define KEY_DOWN    80
+#define KEY_LEFT    75
+#define KEY_RIGHT   77
+#define KEY_HOME    71
+#define KEY_END     79
+#define KEY_PGUP    73
+#define KEY_PGDN    81
+#define KEY_DELETE  83
+#define KEY_ENTER   13
+#define KEY_ESC     27
+#define KEY_CTRL_Q  17
+#define KEY_BACKSPACE 8
+#define KEY_EXTENDED  224   // Prefix of arrow and function keys (0 on some keyboards)
+#define KEY_NONE    -1      // Input that is not a key, e.g. an unknown escape sequence
+
+// The terminal the UI runs in: the Win32 console (terminal_win32.c) or a
+// VT terminal in termios raw mode (terminal_vt.c). Both report keys the
+// Windows way, arrows and paging keys as KEY_EXTENDED followed by the
+// scan code. Drawing goes through Screen (screen.h), which writes each
+// frame in one batch. terminal_wait is where the UI thread sleeps: on
+// keys and on a handle other threads signal, in a single blocking call.
+// Process-wide, UI thread only.
+
+// Function declarations
+bool terminal_init(void);
+void terminal_cleanup(void);
+void terminal_get_size(int* width, int* height);
+bool terminal_key_ready(void);
+int terminal_read_key(void);
+int terminal_wait(WaitHandle wake, int timeout_ms);
+
+#endif // TERMINAL_H
@@ -0,0 +1,182 @@
+// VT terminal backend of terminal.h: termios raw mode and ANSI sequences,
+// for Linux consoles, xterm-likes and SSH sessions
+#ifndef _WIN32
+#include "terminal.h"
+#include <stdio.h>
+#include <string.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+// Alternate screen, cleared, cursor hidden, window title; undone on cleanup
+#define VT_ENTER "\x1b[?1049h\x1b[2J\x1b[H\x1b[?25l\x1b]0;GReleaseMon - GitHub Release Tracker\x07"
+#define VT_LEAVE "\x1b[0m\x1b[?25h\x1b[?1049l"
+
+static struct termios g_saved_termios;
+static volatile bool g_active = false;
+static int g_pending_key = KEY_NONE;    // Scan code owed after a KEY_EXTENDED
+
+// Key sequences after ESC [ (or ESC O), by final byte or by number before '~'
+typedef struct {
+    char final;
+    int number;
+    int key;
+} KeySequence;
+
+static const KeySequence g_key_sequences[] = {
+    { 'A', 0, KEY_UP },
+    { 'B', 0, KEY_DOWN },
+    { 'C', 0, KEY_RIGHT },
+    { 'D', 0, KEY_LEFT },
+    { 'H', 0, KEY_HOME },
+    { 'F', 0, KEY_END },
+    { '~', 1, KEY_HOME },
+    { '~', 7, KEY_HOME },
+    { '~', 4, KEY_END },
+    { '~', 8, KEY_END },
+    { '~', 3, KEY_DELETE },
+    { '~', 5, KEY_PGUP },
+    { '~', 6, KEY_PGDN }
+};
+
+static void write_all(const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(STDOUT_FILENO, data, length);
+        if (written <= 0) return;
+        data += written;
+        length -= written;
+    }
+}
+
+bool terminal_init(void) {
+    if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO) ||
+        tcgetattr(STDIN_FILENO, &g_saved_termios) != 0) {
+        fprintf(stderr, "Error: GReleaseMon needs to run in a terminal\n");
+        return false;
+    }
+
+    // Raw input, but Ctrl+C still raises SIGINT so the terminal is restored
+    struct termios raw = g_saved_termios;
+    raw.c_iflag &= ~(BRKINT | ICRNL | INPCK | ISTRIP | IXON);
+    raw.c_lflag &= ~(ECHO | ICANON | IEXTEN);
+    raw.c_cflag |= CS8;
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw) != 0) {
+        fprintf(stderr, "Error: Could not switch the terminal to raw mode\n");
+        return false;
+    }
+
+    g_active = true;
+    write_all(VT_ENTER, sizeof(VT_ENTER) - 1);
+    return true;
+}
+
+// Only async-signal-safe calls, so signal handlers may use it
+void terminal_cleanup(void) {
+    if (!g_active) return;
+
+    g_active = false;
+    write_all(VT_LEAVE, sizeof(VT_LEAVE) - 1);
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &g_saved_termios);
+}
+
+void terminal_get_size(int* width, int* height) {
+    struct winsize size;
+
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0 && size.ws_row > 0) {
+        *width = size.ws_col;
+        *height = size.ws_row;
+    } else {
+        *width = TERMINAL_DEFAULT_WIDTH;
+        *height = TERMINAL_DEFAULT_HEIGHT;
+    }
+}
+
+// Next input byte within timeout_ms (-1: wait), or -1 when none came
+static int read_byte(int timeout_ms) {
+    struct pollfd input = { STDIN_FILENO, POLLIN, 0 };
+    unsigned char byte;
+
+    if (poll(&input, 1, timeout_ms) <= 0 || read(STDIN_FILENO, &byte, 1) != 1) return -1;
+    return byte;
+}
+
+bool terminal_key_ready(void) {
+    struct pollfd input = { STDIN_FILENO, POLLIN, 0 };
+    return g_pending_key != KEY_NONE || poll(&input, 1, 0) > 0;
+}
+
+// Rest of an escape sequence, after ESC and '[' or 'O'
+static int read_key_sequence(void) {
+    int number = 0;
+    bool first_parameter = true;
+    int byte;
+
+    // Parameters run up to the final byte; only the first one names the key
+    while ((byte = read_byte(TERMINAL_ESCAPE_TIMEOUT_MS)) >= 0 && ((byte >= '0' && byte <= '9') || byte == ';')) {
+        if (byte == ';') {
+            first_parameter = false;
+        } else if (first_parameter) {
+            number = number * 10 + (byte - '0');
+        }
+    }
+    if (byte < 0) return KEY_NONE;
+
+    for (size_t i = 0; i < sizeof(g_key_sequences) / sizeof(g_key_sequences[0]); i++) {
+        const KeySequence* sequence = &g_key_sequences[i];
+        if (sequence->final != byte) continue;
+        if (byte == '~' && sequence->number != number) continue;
+
+        g_pending_key = sequence->key;
+        return KEY_EXTENDED;
+    }
+    return KEY_NONE;
+}
+
+int terminal_read_key(void) {
+    if (g_pending_key != KEY_NONE) {
+        int key = g_pending_key;
+        g_pending_key = KEY_NONE;
+        return key;
+    }
+
+    int byte = read_byte(-1);
+    switch (byte) {
+        case 127:
+            return KEY_BACKSPACE;
+        case '\n':
+            return KEY_ENTER;
+        case KEY_ESC:
+            break;
+        default:
+            return byte;
+    }
+
+    // A lone Esc, or the start of a key sequence
+    int next = read_byte(TERMINAL_ESCAPE_TIMEOUT_MS);
+    if (next == '[' || next == 'O') return read_key_sequence();
+    if (next >= 0) g_pending_key = next;    // Alt+key: Esc, then the key
+    return KEY_ESC;
+}
+
+// Sleep in poll on stdin and wake together, so an idle monitor costs no CPU
+int terminal_wait(WaitHandle wake, int timeout_ms) {
+    if (g_pending_key != KEY_NONE) return TERMINAL_EVENT_KEY;
+
+    struct pollfd sources[2] = {
+        { STDIN_FILENO, POLLIN, 0 },
+        { wake, POLLIN, 0 }
+    };
+    int events = 0;
+
+    // EINTR (a resize, say) counts as a timeout; the caller just redraws
+    if (poll(sources, 2, timeout_ms) > 0) {
+        if (sources[0].revents) events |= TERMINAL_EVENT_KEY;
+        if (sources[1].revents & POLLIN) events |= TERMINAL_EVENT_WAKE;
+    }
+    return events;
+}
+
+#endif // !_WIN32
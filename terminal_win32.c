@@ -0,0 +1,122 @@
+// Win32 console backend of terminal.h
+#ifdef _WIN32
+#include "terminal.h"
+#include <stdio.h>
+#include <Windows.h>
+#include <conio.h>
+
+static HANDLE g_output = NULL;
+static WORD g_saved_attributes = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE;
+
+static void set_cursor_visible(BOOL visible) {
+    CONSOLE_CURSOR_INFO cursorInfo;
+    GetConsoleCursorInfo(g_output, &cursorInfo);
+    cursorInfo.bVisible = visible;
+    SetConsoleCursorInfo(g_output, &cursorInfo);
+}
+
+// Blank the whole buffer in the current colors and home the cursor, so it
+// matches the freshly created Screen
+static void clear_buffer(void) {
+    COORD coordScreen = { 0, 0 };
+    DWORD cCharsWritten;
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+
+    if (!GetConsoleScreenBufferInfo(g_output, &csbi)) return;
+    DWORD dwConSize = csbi.dwSize.X * csbi.dwSize.Y;
+
+    FillConsoleOutputCharacter(g_output, (TCHAR)' ', dwConSize, coordScreen, &cCharsWritten);
+    FillConsoleOutputAttribute(g_output, csbi.wAttributes, dwConSize, coordScreen, &cCharsWritten);
+    SetConsoleCursorPosition(g_output, coordScreen);
+}
+
+bool terminal_init(void) {
+    g_output = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (g_output == INVALID_HANDLE_VALUE || g_output == NULL) {
+        fprintf(stderr, "Error: No console to draw on\n");
+        return false;
+    }
+
+    // Enable UTF-8 support
+    SetConsoleOutputCP(CP_UTF8);
+    SetConsoleCP(CP_UTF8);
+
+    // Enable virtual terminal processing for better color support
+    DWORD dwMode = 0;
+    GetConsoleMode(g_output, &dwMode);
+    dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+    SetConsoleMode(g_output, dwMode);
+
+    SetConsoleTitle("GReleaseMon - GitHub Release Tracker");
+
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    if (GetConsoleScreenBufferInfo(g_output, &csbi)) g_saved_attributes = csbi.wAttributes;
+
+    set_cursor_visible(FALSE);
+    clear_buffer();
+    return true;
+}
+
+void terminal_cleanup(void) {
+    if (!g_output) return;
+
+    set_cursor_visible(TRUE);
+    SetConsoleTextAttribute(g_output, g_saved_attributes);
+}
+
+void terminal_get_size(int* width, int* height) {
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi)) {
+        *width = csbi.srWindow.Right - csbi.srWindow.Left + 1;
+        *height = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+    } else {
+        *width = TERMINAL_DEFAULT_WIDTH;
+        *height = TERMINAL_DEFAULT_HEIGHT;
+    }
+}
+
+bool terminal_key_ready(void) {
+    return _kbhit() != 0;
+}
+
+int terminal_read_key(void) {
+    return _getch();
+}
+
+// Mouse, focus, resize and key-up records signal the input handle too, but
+// _getch never consumes them; drop those that do not make a key
+static void discard_non_key_input(HANDLE input) {
+    INPUT_RECORD record;
+    DWORD count;
+
+    while (!_kbhit() && PeekConsoleInput(input, &record, 1, &count) && count > 0) {
+        ReadConsoleInput(input, &record, 1, &count);
+    }
+}
+
+// Sleep in WaitForMultipleObjects on the console input and wake together,
+// so an idle monitor costs no CPU
+int terminal_wait(WaitHandle wake, int timeout_ms) {
+    HANDLE handles[2] = { GetStdHandle(STD_INPUT_HANDLE), wake };
+    DWORD start = GetTickCount();
+    DWORD timeout = timeout_ms < 0 ? INFINITE : (DWORD)timeout_ms;
+
+    for (;;) {
+        // Also covers the scan code _getch holds back after KEY_EXTENDED
+        if (_kbhit()) return TERMINAL_EVENT_KEY;
+
+        DWORD result = WaitForMultipleObjects(2, handles, FALSE, timeout);
+        if (result == WAIT_OBJECT_0 + 1) return TERMINAL_EVENT_WAKE;
+        if (result != WAIT_OBJECT_0) return 0;
+
+        discard_non_key_input(handles[0]);
+        if (timeout != INFINITE) {
+            DWORD elapsed = GetTickCount() - start;
+            if (elapsed >= (DWORD)timeout_ms) return _kbhit() ? TERMINAL_EVENT_KEY : 0;
+            timeout = (DWORD)timeout_ms - elapsed;
+        }
+    }
+}
+
+#endif // _WIN32
@@ -0,0 +1,92 @@
+// Classifies a table of real-world asset names with the built-in patterns
+// and checks the exact platform bits of each, including names that only
+// start like "win": "wine", "winget", "winter" and the like must not be
+// tagged as Windows. Build line is in "how to compile.txt"; exits
+// non-zero on any mismatch.
+#include "../asset_classifier.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    const char* name;
+    unsigned int expected;
+} AssetCase;
+
+static const AssetCase g_cases[] = {
+    // Windows, by token or extension
+    { "tool-1.2.3-win64.zip", ASSET_WINDOWS | ASSET_X64 },
+    { "tool-1.2.3-win32.zip", ASSET_WINDOWS },
+    { "tool-1.2.3-windows-amd64.zip", ASSET_WINDOWS | ASSET_X64 },
+    { "Tool-Windows-ARM64.msi", ASSET_WINDOWS | ASSET_ARM64 },
+    { "tool-win-x64.zip", ASSET_WINDOWS | ASSET_X64 },
+    { "tool-win-arm64.zip", ASSET_WINDOWS | ASSET_ARM64 },
+    { "tool_win_x64.zip", ASSET_WINDOWS | ASSET_X64 },
+    { "tool-win.zip", ASSET_WINDOWS },
+    { "tool.win.x86.zip", ASSET_WINDOWS },
+    { "setup.exe", ASSET_WINDOWS },
+    { "tool-x86_64-pc-windows-msvc.zip", ASSET_WINDOWS | ASSET_X64 },
+    { "tool-x86_64-w64-mingw32.zip", ASSET_WINDOWS | ASSET_X64 },
+
+    // Words that start like "win" but are not Windows
+    { "wine-9.0.tar.xz", 0 },
+    { "winget-tools-1.0.tar.gz", 0 },
+    { "winter-theme-2.1.tar.gz", 0 },
+    { "winamp-skin.zip", 0 },
+    { "window-manager-0.4.tar.gz", 0 },
+    { "twin-peaks-1.0.tar.gz", 0 },
+
+    // Other platforms and architectures
+    { "tool-1.2.3-x86_64-unknown-linux-gnu.tar.gz", ASSET_LINUX | ASSET_X64 },
+    { "tool-1.2.3-aarch64-unknown-linux-musl.tar.gz", ASSET_LINUX | ASSET_ARM64 },
+    { "tool_1.2.3_amd64.deb", ASSET_LINUX | ASSET_X64 },
+    { "tool-1.2.3.x86_64.rpm", ASSET_LINUX | ASSET_X64 },
+    { "Tool-1.2.3.AppImage", ASSET_LINUX },
+    { "tool-1.2.3-aarch64-apple-darwin.tar.gz", ASSET_MACOS | ASSET_ARM64 },
+    { "tool-1.2.3-macos-universal.dmg", ASSET_MACOS },
+    { "tool-1.2.3-osx.pkg", ASSET_MACOS },
+    { "tool-1.2.3.tar.gz", 0 },
+    { "checksums.txt", 0 },
+    { "tool-linux64.tar.gz", ASSET_LINUX },
+    { "winget-cli_1.7.10861.msixbundle", ASSET_WINDOWS },    // ".msix" starts with ".msi"
+};
+
+int main(void) {
+    if (!asset_classifier_init(NULL, 0)) {
+        fprintf(stderr, "Error: Failed to build the asset classifier\n");
+        return 1;
+    }
+
+    int failures = 0;
+    int count = (int)(sizeof(g_cases) / sizeof(g_cases[0]));
+    for (int i = 0; i < count; i++) {
+        const AssetCase* test = &g_cases[i];
+        unsigned int mask = classify_asset_name(test->name, strlen(test->name));
+        if (mask != test->expected) {
+            fprintf(stderr, "Error: %s classified as 0x%02X, expected 0x%02X\n",
+                    test->name, mask, test->expected);
+            failures++;
+        }
+
+        // Names can arrive split anywhere; the result must not depend on it
+        for (size_t split = 1; split < strlen(test->name); split++) {
+            AssetScan scan;
+            begin_asset_scan(&scan);
+            feed_asset_scan(&scan, test->name, split);
+            feed_asset_scan(&scan, test->name + split, strlen(test->name) - split);
+            if (scan.mask != mask) {
+                fprintf(stderr, "Error: %s split at %zu classified as 0x%02X\n", test->name, split, scan.mask);
+                failures++;
+                break;
+            }
+        }
+    }
+
+    asset_classifier_cleanup();
+
+    if (failures) {
+        fprintf(stderr, "%d asset names misclassified\n", failures);
+        return 1;
+    }
+    printf("asset_classifier_test: %d names classified\n", count);
+    return 0;
+}
@@ -0,0 +1,163 @@
+// Feeds the canned aliased response in graphql_batch_response.json through
+// process_graphql_batch_response and checks the rows it publishes: aliases
+// out of order, a null latestRelease, a repository GitHub could not resolve,
+// one left out of the response, plus a duplicate and an out-of-batch alias
+// that must be ignored. Build line is in "how to compile.txt"; run from the
+// repository folder, or pass the response's path. Exits non-zero on failure.
+#include "../requests.h"
+#include "../release_queue.h"
+#include "../string_table.h"
+#include "../asset_classifier.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_RESPONSE_PATH "tests/graphql_batch_response.json"
+
+typedef struct {
+    const char* owner;
+    const char* repo;
+    bool expect_row;
+    const char* tag;            // "None" for placeholders
+    unsigned char flags;
+    unsigned char platforms;
+    time_t created_at;
+    const char* url;
+    const char* body;           // Unescaped
+} Expected;
+
+// In batch order, so entry N answers to alias rN
+static const Expected g_expected[] = {
+    { "alpha", "tool", true, "v1.2.3", 0, ASSET_WINDOWS | ASSET_LINUX | ASSET_X64, 1714564800,
+      "https://github.com/alpha/tool/releases/tag/v1.2.3", "## Changes\n- Fixed \"quoted\" names" },
+    { "beta", "norelease", true, "None", RELEASE_PLACEHOLDER, 0, 0, NULL, NULL },
+    { "gamma", "gone", true, "None", RELEASE_PLACEHOLDER, 0, 0, NULL, NULL },
+    { "delta", "pre", true, "v0.9.0-rc.1", RELEASE_PRERELEASE, ASSET_MACOS | ASSET_ARM64, 1709251199,
+      "https://github.com/delta/pre/releases/tag/v0.9.0-rc.1", "Release candidate" },
+    { "epsilon", "unanswered", false, NULL, 0, 0, 0, NULL, NULL },
+    { "zeta", "plain", true, "2023.12", 0, 0, 1703980800,
+      "https://github.com/zeta/plain/releases/tag/2023.12", "" },
+};
+
+#define EXPECTED_COUNT ((int)(sizeof(g_expected) / sizeof(g_expected[0])))
+
+static int g_failures = 0;
+
+static void fail(const Expected* expected, const char* what) {
+    fprintf(stderr, "Error: %s/%s: %s\n", expected->owner, expected->repo, what);
+    g_failures++;
+}
+
+static char* read_file(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* data = size >= 0 ? malloc(size + 1) : NULL;
+    if (data && fread(data, 1, size, file) == (size_t)size) {
+        data[size] = '\0';
+    } else {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    return data;
+}
+
+static void check_release(const Expected* expected, const Release* release) {
+    char text[256];
+
+    if (release->tag < 0 || strcmp(get_interned_string(release->tag), expected->tag) != 0) {
+        fail(expected, "wrong tag");
+    }
+    if (release->flags != expected->flags) fail(expected, "wrong flags");
+    if (release->platforms != expected->platforms) fail(expected, "wrong platforms");
+    if (release->created_at != expected->created_at) fail(expected, "wrong created_at");
+
+    if (!expected->url) {
+        if (release->details) fail(expected, "placeholder has details");
+        return;
+    }
+    if (!string_view_equals(get_release_url(release), expected->url)) fail(expected, "wrong url");
+    unescape_json(get_release_body(release), text, sizeof(text));
+    if (strcmp(text, expected->body) != 0) fail(expected, "wrong body");
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 ? argv[1] : DEFAULT_RESPONSE_PATH;
+
+    if (!string_table_init() || !asset_classifier_init(NULL, 0)) {
+        fprintf(stderr, "Error: Failed to initialize\n");
+        return 1;
+    }
+
+    char* response = read_file(path);
+    if (!response) {
+        fprintf(stderr, "Error: Cannot read %s\n", path);
+        return 1;
+    }
+
+    RepoInfo repos[EXPECTED_COUNT];
+    for (int i = 0; i < EXPECTED_COUNT; i++) {
+        repos[i].owner_id = intern_string(g_expected[i].owner);
+        repos[i].repo_id = intern_string(g_expected[i].repo);
+        repos[i].owner = get_interned_string(repos[i].owner_id);
+        repos[i].repo = get_interned_string(repos[i].repo_id);
+    }
+
+    ReleaseQueue* results = create_release_queue();
+    ReleaseCollection* releases = create_release_collection(EXPECTED_COUNT);
+    if (!results || !releases) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+
+    // The unanswered repository is reported on stderr; that line is expected
+    process_graphql_batch_response(repos, EXPECTED_COUNT, 200, response, results);
+    drain_release_queue(results, releases);
+
+    for (int i = 0; i < EXPECTED_COUNT; i++) {
+        const Expected* expected = &g_expected[i];
+        const Release* found = NULL;
+        int matches = 0;
+
+        for (int id = 0; id < releases->count; id++) {
+            const Release* release = get_release(releases, id);
+            if (release->owner == repos[i].owner_id && release->repo == repos[i].repo_id) {
+                found = release;
+                matches++;
+            }
+        }
+
+        if (!expected->expect_row) {
+            if (matches) fail(expected, "row published for a repository missing from the response");
+        } else if (matches != 1) {
+            fail(expected, matches ? "more than one row" : "no row");
+        } else {
+            check_release(expected, found);
+        }
+    }
+
+    int expected_rows = 0;
+    for (int i = 0; i < EXPECTED_COUNT; i++) expected_rows += g_expected[i].expect_row;
+    if (releases->count != expected_rows) {
+        fprintf(stderr, "Error: %d rows published, expected %d\n", releases->count, expected_rows);
+        g_failures++;
+    }
+
+    free_release_collection(releases);
+    free_release_queue(results);
+    free(response);
+    asset_classifier_cleanup();
+    string_table_cleanup();
+
+    if (g_failures) {
+        fprintf(stderr, "%d GraphQL batch checks failed\n", g_failures);
+        return 1;
+    }
+    printf("graphql_batch_test: %d repositories checked\n", EXPECTED_COUNT);
+    return 0;
+}
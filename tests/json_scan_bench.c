@@ -0,0 +1,71 @@
+// Times the structural-index kernels on the large release fixture: the
+// index alone (json_build_index) and the whole DOM parse on top of it
+// (json_parse), once per kernel this CPU supports. Build line is in
+// "how to compile.txt"; run from the repository folder, or pass the
+// fixture's path and a repeat count.
+#include "../json_scan.h"
+#include "../requests.h"
+#include "test_util.h"
+
+#define DEFAULT_FIXTURE_PATH "tests/release_large.json"
+#define DEFAULT_REPEATS 200
+
+static const char* g_kernels[] = { "scalar", "sse2", "avx2" };
+
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 ? argv[1] : DEFAULT_FIXTURE_PATH;
+    int repeats = argc > 2 ? atoi(argv[2]) : DEFAULT_REPEATS;
+    if (repeats < 1) repeats = 1;
+
+    size_t length = 0;
+    char* json = read_test_file(path, &length);
+    if (!json) {
+        fprintf(stderr, "Error: Cannot read %s\n", path);
+        return 1;
+    }
+
+    printf("%s: %zu bytes, best of %d runs\n", path, length, repeats);
+    printf("%-8s %12s %10s %12s %10s\n", "kernel", "index us", "MB/s", "parse us", "MB/s");
+
+    JsonIndex index = {0};
+    JsonDocument doc = {0};
+    double scalar_index = 0;
+    for (size_t k = 0; k < sizeof(g_kernels) / sizeof(g_kernels[0]); k++) {
+        if (!json_scan_use_kernel(g_kernels[k])) {
+            printf("%-8s not supported here\n", g_kernels[k]);
+            continue;
+        }
+
+        // Best run rather than the mean, so a context switch doesn't count
+        double best_index = 1e9;
+        double best_parse = 1e9;
+        size_t positions = 0;
+        for (int i = 0; i < repeats; i++) {
+            double start = bench_seconds();
+            if (!json_build_index(json, length, &index)) {
+                fprintf(stderr, "Error: json_build_index failed\n");
+                return 1;
+            }
+            double middle = bench_seconds();
+            if (!json_parse(json, length, &doc)) {
+                fprintf(stderr, "Error: json_parse failed on %s\n", path);
+                return 1;
+            }
+            double end = bench_seconds();
+
+            positions = index.count;
+            if (middle - start < best_index) best_index = middle - start;
+            if (end - middle < best_parse) best_parse = end - middle;
+        }
+        if (k == 0) scalar_index = best_index;
+
+        printf("%-8s %12.1f %10.0f %12.1f %10.0f   %zu positions, index %.1fx scalar\n",
+               g_kernels[k], best_index * 1e6, length / best_index / 1e6,
+               best_parse * 1e6, length / best_parse / 1e6, positions, scalar_index / best_index);
+    }
+
+    free_json_index(&index);
+    free_json_document(&doc);
+    free(json);
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Checks that every structural-index kernel this CPU supports gives the
+// scalar kernel's output: json_build_index positions and json_scan_string
+// offsets, on the large release fixture and on random buffers of every
+// length and alignment up to a few vector widths, plus some spanning
+// several index blocks. Build line is in "how to compile.txt"; run from the
+// repository folder, or pass the fixture's path. Exits non-zero on failure.
+#include "../json_scan.h"
+#include "test_util.h"
+#include <string.h>
+
+#define DEFAULT_FIXTURE_PATH "tests/release_large.json"
+#define RANDOM_MAX_LENGTH 200
+#define RANDOM_MAX_SHIFT 32
+#define RANDOM_LONG_LENGTH 20000    // Several INDEX_BLOCK_SIZE blocks
+#define RANDOM_LONG_COUNT 50
+
+static const char* g_kernels[] = { "sse2", "avx2" };    // Checked against scalar
+
+static int g_failures = 0;
+static unsigned int g_random = 2463534242u;
+
+static unsigned int next_random(void) {
+    // xorshift32: the same buffers on every run and platform
+    g_random ^= g_random << 13;
+    g_random ^= g_random >> 17;
+    g_random ^= g_random << 5;
+    return g_random;
+}
+
+// Mostly structural characters, their neighbours by one bit, and bytes
+// above 0x7F, which must not fold onto a bracket
+static void fill_random(char* data, size_t len) {
+    static const char alphabet[] = "\"\\,{}[]:a zZ;|\x7B\x5B\x02\x22\xDB\xFB\xA2\xDC\xFD";
+    for (size_t i = 0; i < len; i++) {
+        unsigned int r = next_random();
+        data[i] = (r & 3) ? alphabet[(r >> 2) % (sizeof(alphabet) - 1)] : (char)(r >> 8);
+    }
+}
+
+static bool same_index(const char* data, size_t len, const char* kernel) {
+    JsonIndex expected = {0};
+    JsonIndex actual = {0};
+
+    json_scan_use_kernel("scalar");
+    bool ok = json_build_index(data, len, &expected);
+    json_scan_use_kernel(kernel);
+    ok = ok && json_build_index(data, len, &actual);
+
+    ok = ok && expected.count == actual.count &&
+         memcmp(expected.positions, actual.positions, expected.count * sizeof(unsigned int)) == 0;
+
+    free_json_index(&expected);
+    free_json_index(&actual);
+    return ok;
+}
+
+static bool same_string_scan(const char* data, size_t len, const char* kernel) {
+    json_scan_use_kernel("scalar");
+    size_t expected = json_scan_string(data, len);
+    json_scan_use_kernel(kernel);
+    return json_scan_string(data, len) == expected;
+}
+
+static void check(const char* data, size_t len, const char* kernel, const char* what) {
+    if (!same_index(data, len, kernel) || !same_string_scan(data, len, kernel)) {
+        if (g_failures < 20) {
+            fprintf(stderr, "Error: %s differs from scalar on %s (%zu bytes)\n", kernel, what, len);
+        }
+        g_failures++;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 ? argv[1] : DEFAULT_FIXTURE_PATH;
+    size_t fixture_length = 0;
+    char* fixture = read_test_file(path, &fixture_length);
+    if (!fixture) {
+        fprintf(stderr, "Error: Cannot read %s\n", path);
+        return 1;
+    }
+
+    char* buffer = malloc(RANDOM_LONG_LENGTH + RANDOM_MAX_SHIFT);
+    if (!buffer) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+
+    int checked = 0;
+    for (size_t k = 0; k < sizeof(g_kernels) / sizeof(g_kernels[0]); k++) {
+        const char* kernel = g_kernels[k];
+        if (!json_scan_use_kernel(kernel)) {
+            printf("json_scan_test: %s not supported here, skipped\n", kernel);
+            continue;
+        }
+        checked++;
+
+        check(fixture, fixture_length, kernel, path);
+
+        // String scans start anywhere, usually just past a quote
+        for (size_t start = 0; start < 4096 && start < fixture_length; start++) {
+            if (!same_string_scan(fixture + start, fixture_length - start, kernel)) {
+                fprintf(stderr, "Error: %s string scan differs from scalar at %zu\n", kernel, start);
+                g_failures++;
+                break;
+            }
+        }
+
+        for (size_t len = 0; len <= RANDOM_MAX_LENGTH; len++) {
+            for (size_t shift = 0; shift < RANDOM_MAX_SHIFT; shift++) {
+                fill_random(buffer + shift, len);
+                check(buffer + shift, len, kernel, "random buffer");
+            }
+        }
+        for (int i = 0; i < RANDOM_LONG_COUNT; i++) {
+            size_t len = RANDOM_LONG_LENGTH - (next_random() % 4096);
+            fill_random(buffer + i % RANDOM_MAX_SHIFT, len);
+            check(buffer + i % RANDOM_MAX_SHIFT, len, kernel, "long random buffer");
+        }
+    }
+
+    free(buffer);
+    free(fixture);
+
+    if (g_failures) {
+        fprintf(stderr, "%d kernel comparisons failed\n", g_failures);
+        return 1;
+    }
+    printf("json_scan_test: %d vector kernels match scalar\n", checked);
+    return 0;
+}
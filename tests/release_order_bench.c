@@ -0,0 +1,129 @@
+// Times switching the table between its ten sort orders and selecting
+// facets on a synthetic collection, 50000 records by default: the first
+// time each order is shown (a full sort of its keys), showing it again
+// with nothing new, showing it again after a batch of new records arrived
+// (sort the batch, merge it in) and every facet combination. Build line is
+// in "how to compile.txt"; pass a record count and a batch size to change
+// the defaults.
+#include "../requests.h"
+#include "../release_sort.h"
+#include "../string_table.h"
+#include "../asset_classifier.h"
+#include "test_util.h"
+#include <string.h>
+
+#define DEFAULT_RECORDS 50000
+#define DEFAULT_BATCH 500
+#define FACET_REPEATS 20
+
+static const char* g_field_names[SORT_FIELD_COUNT] = { "repository", "tag", "age", "type", "platforms" };
+static unsigned int g_random = 2463534242u;
+
+static unsigned int next_random(void) {
+    g_random ^= g_random << 13;
+    g_random ^= g_random >> 17;
+    g_random ^= g_random << 5;
+    return g_random;
+}
+
+// A few thousand owners, tags in a handful of schemes so prefixes tie,
+// created within the last five years, one in ten a prerelease
+static bool add_synthetic_releases(ReleaseCollection* collection, int count, time_t now) {
+    static const char* tag_formats[] = { "v%u.%u.%u", "%u.%u.%u", "release-%u.%u.%u", "v%u.%u.%u-rc" };
+
+    for (int i = 0; i < count; i++) {
+        char owner[64], repo[64], tag[48];
+        snprintf(owner, sizeof(owner), "Owner%u", next_random() % 4000);
+        snprintf(repo, sizeof(repo), "project-%d", collection->count);
+        snprintf(tag, sizeof(tag), tag_formats[next_random() % 4],
+                 next_random() % 5, next_random() % 30, next_random() % 10);
+
+        Release release = {0};
+        release.owner = intern_string(owner);
+        release.repo = intern_string(repo);
+        release.tag = intern_string(tag);
+        release.created_at = now - (time_t)(next_random() % (5 * 365 * 86400));
+        release.flags = (next_random() % 10 == 0) ? RELEASE_PRERELEASE : 0;
+        release.platforms = (unsigned char)(next_random() & (ASSET_WINDOWS | ASSET_LINUX | ASSET_MACOS | ASSET_X64 | ASSET_ARM64));
+        if (!add_release_to_collection(collection, &release)) return false;
+    }
+    return true;
+}
+
+// Milliseconds to show one order, or -1 on failure
+static double show_order(ReleaseCollection* collection, int index) {
+    double start = bench_seconds();
+    if (!set_release_order(collection, (SortField)(index / 2), (index % 2) != 0)) return -1;
+    return (bench_seconds() - start) * 1e3;
+}
+
+int main(int argc, char* argv[]) {
+    int records = argc > 1 ? atoi(argv[1]) : DEFAULT_RECORDS;
+    int batch = argc > 2 ? atoi(argv[2]) : DEFAULT_BATCH;
+    if (records < 1) records = 1;
+    if (batch < 1) batch = 1;
+
+    if (!string_table_init() || !asset_classifier_init(NULL, 0)) {
+        fprintf(stderr, "Error: Failed to initialize\n");
+        return 1;
+    }
+
+    time_t now = time(NULL);
+    ReleaseCollection* collection = create_release_collection(records);
+    if (!collection || !add_synthetic_releases(collection, records, now)) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+
+    double first[SORT_ORDER_COUNT], again[SORT_ORDER_COUNT], merged[SORT_ORDER_COUNT];
+    for (int i = 0; i < SORT_ORDER_COUNT; i++) first[i] = show_order(collection, i);
+    for (int i = 0; i < SORT_ORDER_COUNT; i++) again[i] = show_order(collection, i);
+
+    // Each order catches up with the batch the first time it is shown after it
+    if (!add_synthetic_releases(collection, batch, now)) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+    for (int i = 0; i < SORT_ORDER_COUNT; i++) merged[i] = show_order(collection, i);
+
+    printf("%d records, then %d more\n", records, batch);
+    printf("%-14s %10s %10s %14s\n", "order", "first ms", "again ms", "after new ms");
+    for (int i = 0; i < SORT_ORDER_COUNT; i++) {
+        if (first[i] < 0 || again[i] < 0 || merged[i] < 0) {
+            fprintf(stderr, "Error: Failed to sort\n");
+            return 1;
+        }
+        printf("%-10s %-3s %10.2f %10.2f %14.2f\n", g_field_names[i / 2], (i % 2) ? "v" : "^",
+               first[i], again[i], merged[i]);
+    }
+
+    ReleaseView view = {0};
+    printf("%-14s %10s %10s\n", "facets", "best ms", "rows");
+    for (unsigned int facets = 1; facets < (1u << FACET_COUNT); facets++) {
+        char label[32] = "";
+        for (int i = 0; i < FACET_COUNT; i++) {
+            if (facets & (1u << i)) {
+                strcat(label, label[0] ? "+" : "");
+                strcat(label, facet_label(i));
+            }
+        }
+
+        double best = 1e9;
+        for (int r = 0; r < FACET_REPEATS; r++) {
+            double start = bench_seconds();
+            if (!select_releases(collection, facets, &view)) {
+                fprintf(stderr, "Error: Failed to select facets\n");
+                return 1;
+            }
+            double elapsed = bench_seconds() - start;
+            if (elapsed < best) best = elapsed;
+        }
+        printf("%-14s %10.3f %10d\n", label, best * 1e3, view.count);
+    }
+
+    free_release_view(&view);
+    free_release_collection(collection);
+    asset_classifier_cleanup();
+    string_table_cleanup();
+    return 0;
+}
@@ -0,0 +1,217 @@
+// Compares the compact Release row against the old inline layout (owner,
+// repo, tag, URL and age text in one ~1 KB struct) on synthetic tables:
+// bytes per row, a draw_table-style scan over every row in table order
+// (names, tag, age and flags, or only the fixed-size fields), and a
+// newest-first sort (qsort of whole structs before, a key sort of
+// the order now). Build line is in "how to compile.txt"; pass row counts
+// to replace the default 10000 and 100000.
+#include "../requests.h"
+#include "../release_sort.h"
+#include "../string_table.h"
+#include "../asset_classifier.h"
+#include "test_util.h"
+#include <string.h>
+
+#define DEFAULT_ROW_COUNTS { 10000, 100000 }
+#define SCAN_REPEATS 20
+#define SORT_REPEATS 5
+#define BODY_TEXT "## Changes\\n- Fixed a crash on startup\\n- Faster release lookups\\n" \
+                  "- Updated dependencies\\n\\n**Full Changelog**: v1.2.2...v1.2.3"
+
+// Release as it was before the hot/cold split
+typedef struct {
+    char owner[128];
+    char repo[128];
+    char tag_name[128];
+    char url[512];
+    char* body;
+    bool prerelease;
+    time_t created_at;
+    char time_difference[64];
+    bool has_windows_assets;
+} LegacyRelease;
+
+static volatile unsigned long long g_sink;  // Keeps the scans from being optimized away
+static unsigned int g_random = 2463534242u;
+
+static unsigned int next_random(void) {
+    g_random ^= g_random << 13;
+    g_random ^= g_random >> 17;
+    g_random ^= g_random << 5;
+    return g_random;
+}
+
+// The same synthetic release in both layouts: a few thousand owners,
+// created within the last five years, one in ten a prerelease
+static bool add_synthetic_release(ReleaseCollection* collection, LegacyRelease* legacy, int i, time_t now) {
+    char owner[64], repo[64], tag[32], url[256];
+    snprintf(owner, sizeof(owner), "owner%u", next_random() % 4000);
+    snprintf(repo, sizeof(repo), "project-%d", i);
+    snprintf(tag, sizeof(tag), "v%u.%u.%u", next_random() % 5, next_random() % 30, next_random() % 10);
+    snprintf(url, sizeof(url), "https://github.com/%s/%s/releases/tag/%s", owner, repo, tag);
+
+    Release release = {0};
+    release.owner = intern_string(owner);
+    release.repo = intern_string(repo);
+    release.tag = intern_string(tag);
+    release.created_at = now - (time_t)(next_random() % (5 * 365 * 86400));
+    release.flags = (next_random() % 10 == 0) ? RELEASE_PRERELEASE : 0;
+    release.platforms = (unsigned char)(next_random() & (ASSET_WINDOWS | ASSET_LINUX | ASSET_MACOS | ASSET_X64 | ASSET_ARM64));
+    if (!set_release_text(&release, make_string_view(url), make_string_view(BODY_TEXT)) ||
+        !add_release_to_collection(collection, &release)) {
+        return false;
+    }
+
+    memset(legacy, 0, sizeof(LegacyRelease));
+    snprintf(legacy->owner, sizeof(legacy->owner), "%s", owner);
+    snprintf(legacy->repo, sizeof(legacy->repo), "%s", repo);
+    snprintf(legacy->tag_name, sizeof(legacy->tag_name), "%s", tag);
+    snprintf(legacy->url, sizeof(legacy->url), "%s", url);
+    legacy->body = malloc(sizeof(BODY_TEXT));
+    if (!legacy->body) return false;
+    memcpy(legacy->body, BODY_TEXT, sizeof(BODY_TEXT));
+    legacy->prerelease = (release.flags & RELEASE_PRERELEASE) != 0;
+    legacy->created_at = release.created_at;
+    format_release_age(release.created_at, legacy->time_difference, sizeof(legacy->time_difference));
+    legacy->has_windows_assets = (release.platforms & ASSET_WINDOWS) != 0;
+    return true;
+}
+
+static int compare_legacy_by_date(const void* a, const void* b) {
+    const LegacyRelease* release_a = (const LegacyRelease*)a;
+    const LegacyRelease* release_b = (const LegacyRelease*)b;
+
+    if (release_a->created_at > release_b->created_at) return -1;
+    if (release_a->created_at < release_b->created_at) return 1;
+    return 0;
+}
+
+// What draw_table_row read of every row: names, tag, age and flags
+static void scan_legacy(const LegacyRelease* releases, int count) {
+    unsigned long long sum = 0;
+    for (int i = 0; i < count; i++) {
+        const LegacyRelease* release = &releases[i];
+        sum += (unsigned char)release->owner[0] + (unsigned char)release->repo[0] +
+               (unsigned char)release->tag_name[0] + (unsigned char)release->time_difference[0] +
+               release->prerelease + release->has_windows_assets + (unsigned long long)release->created_at;
+    }
+    g_sink = sum;
+}
+
+static void scan_compact(const ReleaseCollection* collection, bool table_order) {
+    unsigned long long sum = 0;
+    for (int row = 0; row < collection->order->count; row++) {
+        const Release* release = table_order ? get_release_at(collection, row) : get_release(collection, row);
+        sum += (unsigned char)get_interned_string(release->owner)[0] +
+               (unsigned char)get_interned_string(release->repo)[0] +
+               (unsigned char)get_interned_string(release->tag)[0] +
+               release->flags + release->platforms + (unsigned long long)release->created_at;
+    }
+    g_sink = sum;
+}
+
+// What facets and the age refresh read: date and flags, no names
+static void scan_legacy_hot(const LegacyRelease* releases, int count) {
+    unsigned long long sum = 0;
+    for (int i = 0; i < count; i++) {
+        sum += releases[i].prerelease + releases[i].has_windows_assets + (unsigned long long)releases[i].created_at;
+    }
+    g_sink = sum;
+}
+
+static void scan_compact_hot(const ReleaseCollection* collection, bool table_order) {
+    unsigned long long sum = 0;
+    for (int row = 0; row < collection->order->count; row++) {
+        const Release* release = table_order ? get_release_at(collection, row) : get_release(collection, row);
+        sum += release->flags + release->platforms + (unsigned long long)release->created_at;
+    }
+    g_sink = sum;
+}
+
+static bool run(int count) {
+    time_t now = time(NULL);
+    ReleaseCollection* collection = create_release_collection(count);
+    LegacyRelease* legacy = malloc((size_t)count * sizeof(LegacyRelease));
+    LegacyRelease* sorted = malloc((size_t)count * sizeof(LegacyRelease));
+    if (!collection || !legacy || !sorted) return false;
+
+    for (int i = 0; i < count; i++) {
+        if (!add_synthetic_release(collection, &legacy[i], i, now)) return false;
+    }
+    if (!sync_release_order(collection)) return false;
+
+    size_t compact_bytes = sizeof(Release) + sizeof(ReleaseDetails) +
+                           strlen(legacy[0].url) + 1 + sizeof(BODY_TEXT);
+    size_t legacy_bytes = sizeof(LegacyRelease) + sizeof(BODY_TEXT);
+    printf("%d rows: %zu bytes per row before (%zu inline), %zu now (%zu hot)\n",
+           count, legacy_bytes, sizeof(LegacyRelease), compact_bytes, sizeof(Release));
+
+    // Sort from arrival order each time; the newest-first order is the
+    // table's default, emptied so it is sorted in full again
+    ReleaseOrder* newest = &collection->orders[SORT_BY_AGE * 2 + 1];
+    double best_legacy = 1e9, best_compact = 1e9;
+    for (int i = 0; i < SORT_REPEATS; i++) {
+        memcpy(sorted, legacy, (size_t)count * sizeof(LegacyRelease));
+        double start = bench_seconds();
+        qsort(sorted, count, sizeof(LegacyRelease), compare_legacy_by_date);
+        double middle = bench_seconds();
+        newest->count = 0;
+        if (!set_release_order(collection, SORT_BY_AGE, true)) return false;
+        double end = bench_seconds();
+        if (middle - start < best_legacy) best_legacy = middle - start;
+        if (end - middle < best_compact) best_compact = end - middle;
+    }
+    printf("  sort:     %8.3f ms before, %8.3f ms now (%.1fx)\n",
+           best_legacy * 1e3, best_compact * 1e3, best_legacy / best_compact);
+
+    // Scans walk the table order: the sorted copy before, the order's keys
+    // now. Record order, as facets and the search index see the rows, shows
+    // what the indirection through the order costs.
+    static const char* scan_names[2] = { "row scan", "hot scan" };
+    for (int hot = 0; hot < 2; hot++) {
+        double best[3] = { 1e9, 1e9, 1e9 };
+        for (int i = 0; i < SCAN_REPEATS; i++) {
+            double times[4];
+            times[0] = bench_seconds();
+            if (hot) scan_legacy_hot(sorted, count); else scan_legacy(sorted, count);
+            times[1] = bench_seconds();
+            if (hot) scan_compact_hot(collection, true); else scan_compact(collection, true);
+            times[2] = bench_seconds();
+            if (hot) scan_compact_hot(collection, false); else scan_compact(collection, false);
+            times[3] = bench_seconds();
+            for (int k = 0; k < 3; k++) {
+                if (times[k + 1] - times[k] < best[k]) best[k] = times[k + 1] - times[k];
+            }
+        }
+        printf("  %s: %8.3f ms before, %8.3f ms now (%.1fx), %.3f ms now by record\n", scan_names[hot],
+               best[0] * 1e3, best[1] * 1e3, best[0] / best[1], best[2] * 1e3);
+    }
+
+    for (int i = 0; i < count; i++) free(legacy[i].body);
+    free(sorted);
+    free(legacy);
+    free_release_collection(collection);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    static const int default_counts[] = DEFAULT_ROW_COUNTS;
+
+    if (!string_table_init() || !asset_classifier_init(NULL, 0)) {
+        fprintf(stderr, "Error: Failed to initialize\n");
+        return 1;
+    }
+
+    int run_count = argc > 1 ? argc - 1 : (int)(sizeof(default_counts) / sizeof(default_counts[0]));
+    for (int i = 0; i < run_count; i++) {
+        int count = argc > 1 ? atoi(argv[i + 1]) : default_counts[i];
+        if (count < 1 || !run(count)) {
+            fprintf(stderr, "Error: Benchmark of %d rows failed\n", count);
+            return 1;
+        }
+    }
+
+    asset_classifier_cleanup();
+    string_table_cleanup();
+    return 0;
+}
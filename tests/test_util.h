@@ -0,0 +1,45 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+// Helpers shared by the standalone tests and benchmarks in this folder
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../platform.h"
+
+// Whole file, NUL-terminated; NULL if it cannot be read. Caller frees.
+static inline char* read_test_file(const char* path, size_t* length) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* data = size >= 0 ? malloc(size + 1) : NULL;
+    if (data && fread(data, 1, size, file) == (size_t)size) {
+        data[size] = '\0';
+        if (length) *length = (size_t)size;
+    } else {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    return data;
+}
+
+// Seconds since an arbitrary start, for timing
+static inline double bench_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER now, frequency;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&frequency);
+    return (double)now.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+#endif
+}
+
+#endif // TEST_UTIL_H
@@ -0,0 +1,84 @@
+// Times parse_timestamp against the sscanf + timegm (_mkgmtime on Windows)
+// parse it replaced, on a table of distinct created_at strings from the
+// last twenty years. Both must agree on every string. Build line is in
+// "how to compile.txt"; pass a string count and a repeat count to change
+// the defaults.
+#include "../requests.h"
+#include "test_util.h"
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_COUNT 100000
+#define DEFAULT_REPEATS 20
+#define TIMESTAMP_SIZE 24
+#define NEWEST_EPOCH 1767225600LL     // 2026-01-01T00:00:00Z
+#define SPAN_SECONDS (20LL * 365 * 86400)
+
+static volatile long long g_sink;     // Keeps the parses from being optimized away
+
+// The conversion parse_timestamp replaced
+static time_t parse_with_sscanf(const char* text) {
+    struct tm tm = {0};
+    sscanf(text, "%d-%d-%dT%d:%d:%d",
+           &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+           &tm.tm_hour, &tm.tm_min, &tm.tm_sec);
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+#ifdef _WIN32
+    return _mkgmtime(&tm);
+#else
+    return timegm(&tm);
+#endif
+}
+
+static double time_parser(time_t (*parse)(const char*), const char* texts, int count, int repeats) {
+    double best = 1e9;
+    for (int r = 0; r < repeats; r++) {
+        long long sum = 0;
+        double start = bench_seconds();
+        for (int i = 0; i < count; i++) sum += parse(texts + (size_t)i * TIMESTAMP_SIZE);
+        double elapsed = bench_seconds() - start;
+        g_sink = sum;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : DEFAULT_COUNT;
+    int repeats = argc > 2 ? atoi(argv[2]) : DEFAULT_REPEATS;
+    if (count < 1) count = 1;
+    if (repeats < 1) repeats = 1;
+
+    char* texts = malloc((size_t)count * TIMESTAMP_SIZE);
+    if (!texts) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+
+    // Spread evenly so every field varies, newest last like a feed
+    for (int i = 0; i < count; i++) {
+        time_t value = (time_t)(NEWEST_EPOCH - SPAN_SECONDS + SPAN_SECONDS * i / count);
+        struct tm* tm = gmtime(&value);
+        strftime(texts + (size_t)i * TIMESTAMP_SIZE, TIMESTAMP_SIZE, "%Y-%m-%dT%H:%M:%SZ", tm);
+    }
+
+    for (int i = 0; i < count; i++) {
+        const char* text = texts + (size_t)i * TIMESTAMP_SIZE;
+        if (parse_timestamp(text) != parse_with_sscanf(text)) {
+            fprintf(stderr, "Error: Parsers disagree on %s\n", text);
+            return 1;
+        }
+    }
+
+    double fixed = time_parser(parse_timestamp, texts, count, repeats);
+    double scanned = time_parser(parse_with_sscanf, texts, count, repeats);
+
+    printf("%d timestamps, best of %d runs\n", count, repeats);
+    printf("  sscanf + timegm:  %8.2f ms  %6.1f ns each\n", scanned * 1e3, scanned * 1e9 / count);
+    printf("  parse_timestamp:  %8.2f ms  %6.1f ns each  (%.1fx)\n",
+           fixed * 1e3, fixed * 1e9 / count, scanned / fixed);
+
+    free(texts);
+    return 0;
+}
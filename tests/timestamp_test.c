@@ -0,0 +1,153 @@
+// Round-trip check of parse_timestamp over its whole domain: every day from
+// 0001-01-01 to 9999-12-31, each at the boundary times of a day, plus every
+// second of one leap day. Expected values come from walking the calendar a
+// day at a time, and each day is also checked against gmtime wherever the
+// C library can represent it. Malformed and impossible dates must parse to
+// 0. Build line is in "how to compile.txt"; exits non-zero on any mismatch.
+#include "../requests.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define FIRST_DAY_EPOCH (-62135596800LL)    // 0001-01-01T00:00:00Z
+#define LAST_YEAR 9999
+#define LEAP_DAY_EPOCH 1709164800LL         // 2024-02-29T00:00:00Z
+
+static int g_failures = 0;
+static long long g_checked = 0;
+static long long g_gmtime_days = 0;   // Days gmtime could confirm
+
+// Seconds into a day where carries happen: minute, hour and noon turns
+static const int g_day_times[] = {
+    0, 1, 59, 60, 3599, 3600, 43199, 43200, 86340, 86399,
+};
+
+static void check(const char* text, time_t expected) {
+    time_t parsed = parse_timestamp(text);
+    g_checked++;
+    if (parsed != expected) {
+        if (g_failures < 20) {
+            fprintf(stderr, "Error: %s parsed to %lld, expected %lld\n", text,
+                    (long long)parsed, (long long)expected);
+        }
+        g_failures++;
+    }
+}
+
+static void put_digits(char* out, int value) {
+    out[0] = (char)('0' + value / 10);
+    out[1] = (char)('0' + value % 10);
+}
+
+// date is "YYYY-MM-DDT"; the time is filled in without snprintf, which
+// would otherwise take most of the run
+static void check_time(const char* date, int second_of_day, long long day_epoch) {
+    char text[32];
+    memcpy(text, date, 11);
+    put_digits(text + 11, second_of_day / 3600);
+    text[13] = ':';
+    put_digits(text + 14, second_of_day / 60 % 60);
+    text[16] = ':';
+    put_digits(text + 17, second_of_day % 60);
+    memcpy(text + 19, "Z", 2);
+    check(text, (time_t)(day_epoch + second_of_day));
+}
+
+static bool is_leap_year(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int days_in_month(int year, int month) {
+    static const int days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return (month == 2 && is_leap_year(year)) ? 29 : days[month - 1];
+}
+
+// Cross-check the calendar walk against gmtime, where the C library covers the day
+static void check_calendar(int year, int month, int day, long long day_epoch) {
+    time_t value = (time_t)day_epoch;
+    if ((long long)value != day_epoch) return;
+
+    struct tm result;
+#ifdef _WIN32
+    struct tm* tm = gmtime_s(&result, &value) == 0 ? &result : NULL;
+#else
+    struct tm* tm = gmtime_r(&value, &result);
+#endif
+    if (!tm) return;   // Outside what this C library handles
+    g_gmtime_days++;
+    if (tm->tm_year + 1900 != year || tm->tm_mon + 1 != month || tm->tm_mday != day ||
+        tm->tm_hour != 0 || tm->tm_min != 0 || tm->tm_sec != 0) {
+        if (g_failures < 20) {
+            fprintf(stderr, "Error: gmtime(%lld) is not %04d-%02d-%02d\n", day_epoch, year, month, day);
+        }
+        g_failures++;
+    }
+}
+
+int main(void) {
+    long long day_epoch = FIRST_DAY_EPOCH;
+    long long days = 0;
+    for (int year = 1; year <= LAST_YEAR; year++) {
+        for (int month = 1; month <= 12; month++) {
+            for (int day = 1; day <= days_in_month(year, month); day++) {
+                char date[32];
+                snprintf(date, sizeof(date), "%04d-%02d-%02dT", year, month, day);
+                check_calendar(year, month, day, day_epoch);
+                for (size_t i = 0; i < sizeof(g_day_times) / sizeof(g_day_times[0]); i++) {
+                    check_time(date, g_day_times[i], day_epoch);
+                }
+                day_epoch += 86400;
+                days++;
+            }
+        }
+    }
+    if (days != 3652059) {
+        fprintf(stderr, "Error: walked %lld days, expected 3652059\n", days);
+        g_failures++;
+    }
+
+    for (int second = 0; second < 86400; second++) {
+        check_time("2024-02-29T", second, LEAP_DAY_EPOCH);
+    }
+
+    // A leap second is accepted and lands on the next minute's first second
+    check("2016-12-31T23:59:60Z", 1483228800);
+    check("9999-12-31T23:59:60Z", 253402300800LL);
+    check("2024-05-01T12:00:00Z trailing", 1714564800);
+
+    static const char* malformed[] = {
+        "",
+        "2024-05-01",
+        "2024-05-01T12:00:00",
+        "2024-05-01 12:00:00Z",
+        "2024/05/01T12:00:00Z",
+        "2024-5-01T12:00:00Z",
+        "2024-00-01T12:00:00Z",
+        "2024-13-01T12:00:00Z",
+        "2024-04-31T12:00:00Z",
+        "2023-02-29T12:00:00Z",
+        "1900-02-29T12:00:00Z",
+        "2100-02-29T12:00:00Z",
+        "2024-05-00T12:00:00Z",
+        "2024-05-32T12:00:00Z",
+        "2024-05-01T24:00:00Z",
+        "2024-05-01T12:60:00Z",
+        "2024-05-01T12:00:61Z",
+        "2024-05-01T1a:00:00Z",
+        "20x4-05-01T12:00:00Z",
+        "-024-05-01T12:00:00Z",
+        "+024-05-01T12:00:00Z",
+        " 024-05-01T12:00:00Z",
+    };
+    for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++) {
+        check(malformed[i], 0);
+    }
+
+    if (g_failures) {
+        fprintf(stderr, "%d timestamp checks failed\n", g_failures);
+        return 1;
+    }
+    printf("timestamp_test: %lld days (%lld confirmed by gmtime), %lld timestamps passed\n",
+           days, g_gmtime_days, g_checked);
+    return 0;
+}
@@ -1,54 +1,29 @@
 #include "ui.h"
+#include "http_pool.h"
+#include "scheduler.h"
+#include "asset_classifier.h"
+#include "string_table.h"
+#include "release_sort.h"
+#include "screen.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <Windows.h>
-#include <conio.h>
 
-void setup_windows_console(void) {
-    // Enable UTF-8 support
-    SetConsoleOutputCP(CP_UTF8);
-    SetConsoleCP(CP_UTF8);
-    
-    // Enable virtual terminal processing for better color support
-    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-    DWORD dwMode = 0;
-    GetConsoleMode(hOut, &dwMode);
-    dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
-    SetConsoleMode(hOut, dwMode);
-    
-    // Set console title
-    SetConsoleTitle("GReleaseMon - GitHub Release Tracker");
-}
+// Direction a column starts in when first sorted by: names A to Z, the
+// rest newest, prereleases and most platforms first
+static const bool g_sort_descending[SORT_FIELD_COUNT] = { false, false, true, true, true };
 
-void init_ui(void) {
-    setup_windows_console();
-    
-    // Hide cursor
-    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-    CONSOLE_CURSOR_INFO cursorInfo;
-    GetConsoleCursorInfo(hOut, &cursorInfo);
-    cursorInfo.bVisible = FALSE;
-    SetConsoleCursorInfo(hOut, &cursorInfo);
-    
-    // Clear screen
-    system("cls");
+// Console or terminal setup lives in the backend, see terminal.h
+bool init_ui(void) {
+    return terminal_init();
 }
 
 void cleanup_ui(void) {
-    // Show cursor
-    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-    CONSOLE_CURSOR_INFO cursorInfo;
-    GetConsoleCursorInfo(hOut, &cursorInfo);
-    cursorInfo.bVisible = TRUE;
-    SetConsoleCursorInfo(hOut, &cursorInfo);
-    
-    // Reset colors
-    SetConsoleTextAttribute(hOut, CONSOLE_COLOR_NORMAL);
+    terminal_cleanup();
 }
 
 void setup_colors(void) {
-    // Colors are handled per-print in Windows Console API
+    // Colors are set per cell in the Screen
     // No global color initialization needed
 }
 
@@ -56,11 +31,7 @@ UIState* create_ui_state(Config* config, ReleaseCollection* releases) {
     UIState* state = calloc(1, sizeof(UIState));
     if (!state) return NULL;
     
-    state->hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-    GetConsoleScreenBufferInfo(state->hConsole, &state->csbi);
-    
-    state->console_width = state->csbi.srWindow.Right - state->csbi.srWindow.Left + 1;
-    state->console_height = state->csbi.srWindow.Bottom - state->csbi.srWindow.Top + 1;
+    terminal_get_size(&state->console_width, &state->console_height);
     
     state->selected_row = 1;
     state->table_start_row = 0;
@@ -69,78 +40,181 @@ UIState* create_ui_state(Config* config, ReleaseCollection* releases) {
     state->current_mode = MODE_TABLE;
     state->releases = releases;
     state->config = config;
+    state->sort_field = SORT_BY_AGE;
+    state->sort_descending = true;
+    
+    // A few screens' worth, so paging back and forth mostly hits
+    int cache_size = TABLE_ROW_CACHE_MIN;
+    while (cache_size < state->visible_rows * 4) cache_size *= 2;
+    state->row_cache = malloc(cache_size * sizeof(TableRow));
+    state->row_cache_mask = cache_size - 1;
+    state->screen = create_screen(state->console_width, state->console_height, CONSOLE_COLOR_NORMAL);
+    if (!state->row_cache || !state->screen) {
+        free_ui_state(state);
+        return NULL;
+    }
+    for (int i = 0; i < cache_size; i++) {
+        state->row_cache[i].id = -1;
+    }
     
     return state;
 }
 
 void free_ui_state(UIState* state) {
     if (state) {
+        free_release_view(&state->view);
+        free(state->row_cache);
+        free_screen(state->screen);
         free(state);
     }
 }
 
-void clear_console(UIState* state) {
-    COORD coordScreen = { 0, 0 };    // home for the cursor
-    DWORD cCharsWritten;
-    CONSOLE_SCREEN_BUFFER_INFO csbi;
-    DWORD dwConSize;
+// Modes that keep the release table on screen
+bool shows_table(const UIState* state) {
+    return state->current_mode == MODE_TABLE || state->current_mode == MODE_SEARCH ||
+           state->current_mode == MODE_GOTO;
+}
 
-    // Get the number of character cells in the current buffer.
-    if (!GetConsoleScreenBufferInfo(state->hConsole, &csbi)) {
-        return;
+static bool is_filtered(UIState* state) {
+    return state->search_length > 0 || state->facets != 0;
+}
+
+// Rows on screen: the filtered view while filtering, else the whole table
+static int get_row_count(UIState* state) {
+    return is_filtered(state) ? state->view.count : state->releases->order->count;
+}
+
+static int get_row_release_id(UIState* state, int row) {
+    return is_filtered(state) ? state->view.ids[row] : state->releases->order->keys[row].id;
+}
+
+// Record number of the selected row, -1 when nothing is selected
+int get_selected_release_id(UIState* state) {
+    if (state->selected_row < 1 || state->selected_row > get_row_count(state)) return -1;
+    return get_row_release_id(state, state->selected_row - 1);
+}
+
+// Re-run the search and facets, e.g. after new releases arrived, keeping
+// the selection in range
+void apply_filters(UIState* state) {
+    bool ok = true;
+    if (state->search_length > 0) {
+        ok = filter_releases(state->releases, state->search, &state->view);
+        if (ok && state->facets) keep_faceted_releases(state->releases, state->facets, &state->view);
+    } else if (state->facets) {
+        ok = select_releases(state->releases, state->facets, &state->view);
+    }
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to allocate memory for filter results\n");
     }
-    dwConSize = csbi.dwSize.X * csbi.dwSize.Y;
 
-    // Fill the entire screen with blanks.
-    if (!FillConsoleOutputCharacter(state->hConsole,        // Handle to console screen buffer
-                                   (TCHAR) ' ',             // Character to write to the buffer
-                                   dwConSize,               // Number of cells to write
-                                   coordScreen,             // Coordinates of first cell
-                                   &cCharsWritten)) {       // Receive number of characters written
-        return;
+    state->total_rows = get_row_count(state);
+    if (state->selected_row > state->total_rows) state->selected_row = state->total_rows;
+    if (state->selected_row < 1) state->selected_row = 1;
+    if (state->table_start_row > state->selected_row - 1) state->table_start_row = state->selected_row - 1;
+}
+
+// Select a row, clamped to the table, scrolling no further than needed to
+// show it. Constant time, so paging and jumps cost the same at any length.
+static void select_row(UIState* state, int row) {
+    if (row > state->total_rows - 1) row = state->total_rows - 1;
+    if (row < 0) row = 0;
+
+    state->selected_row = row + 1;
+    if (row < state->table_start_row) {
+        state->table_start_row = row;
+    } else if (row >= state->table_start_row + state->visible_rows) {
+        state->table_start_row = row - state->visible_rows + 1;
     }
+}
 
-    // Get the current text attribute.
-    if (!GetConsoleScreenBufferInfo(state->hConsole, &csbi)) {
-        return;
+// Scroll a page at a time, the selection moving with the page
+static void page_table(UIState* state, int direction) {
+    int last_start = state->total_rows - state->visible_rows;
+    
+    state->table_start_row += direction * state->visible_rows;
+    if (state->table_start_row > last_start) state->table_start_row = last_start;
+    if (state->table_start_row < 0) state->table_start_row = 0;
+    select_row(state, state->selected_row - 1 + direction * state->visible_rows);
+}
+
+// Move the selection to a record, scrolling it into view; nothing happens
+// when the record is filtered out
+static void select_release_id(UIState* state, int id) {
+    int row = -1;
+
+    if (id < 0) return;
+    if (!is_filtered(state)) {
+        row = state->releases->rows[id];
+    } else {
+        for (int i = 0; i < state->view.count && row < 0; i++) {
+            if (state->view.ids[i] == id) row = i;
+        }
     }
+    if (row < 0) return;
+
+    state->selected_row = row + 1;
+    if (row < state->table_start_row || row >= state->table_start_row + state->visible_rows) {
+        state->table_start_row = row - state->visible_rows / 2;
+        if (state->table_start_row < 0) state->table_start_row = 0;
+    }
+}
 
-    // Fill the entire screen with the current colors.
-    if (!FillConsoleOutputAttribute(state->hConsole,        // Handle to console screen buffer
-                                   csbi.wAttributes,        // Character attributes to use
-                                   dwConSize,               // Number of cells to write
-                                   coordScreen,             // Coordinates of first cell
-                                   &cCharsWritten)) {       // Receive number of characters written
+// Sort by another column, or flip the direction of the current one. The
+// selected release stays selected wherever it ends up.
+static void sort_table(UIState* state, SortField field) {
+    bool descending = (field == state->sort_field) ? !state->sort_descending : g_sort_descending[field];
+    int selected = get_selected_release_id(state);
+
+    if (!set_release_order(state->releases, field, descending)) {
+        fprintf(stderr, "Error: Failed to allocate memory for sorting\n");
         return;
     }
+    state->sort_field = field;
+    state->sort_descending = descending;
+    apply_filters(state);
+    select_release_id(state, selected);
+}
+
+static void toggle_facet(UIState* state, unsigned int facet) {
+    int selected = get_selected_release_id(state);
 
-    // Put the cursor at its home coordinates.
-    SetConsoleCursorPosition(state->hConsole, coordScreen);
+    state->facets ^= facet;
+    apply_filters(state);
+    select_release_id(state, selected);
 }
 
-void set_console_cursor_position(UIState* state, int x, int y) {
-    COORD pos = {x, y};
-    SetConsoleCursorPosition(state->hConsole, pos);
+// Search text and facet labels for the footer, e.g. "qt [Pre 7d]"
+static void format_filters(UIState* state, char* buffer, size_t size) {
+    size_t len = snprintf(buffer, size, "%s", state->search);
+    if (!state->facets || len >= size) return;
+
+    len += snprintf(buffer + len, size - len, "%s[", len ? " " : "");
+    for (int i = 0; i < FACET_COUNT && len < size; i++) {
+        if (state->facets & (1u << i)) {
+            len += snprintf(buffer + len, size - len, "%s%s",
+                            buffer[len - 1] == '[' ? "" : " ", facet_label(i));
+        }
+    }
+    if (len < size) snprintf(buffer + len, size - len, "]");
 }
 
-void set_console_color(UIState* state, WORD color) {
-    SetConsoleTextAttribute(state->hConsole, color);
+// Drawing goes to the back buffer of state->screen; nothing reaches the
+// console until flush_screen sends what changed
+void clear_console(UIState* state) {
+    screen_clear(state->screen, CONSOLE_COLOR_NORMAL);
 }
 
 void print_at(UIState* state, int x, int y, const char* text) {
-    set_console_cursor_position(state, x, y);
-    printf("%s", text);
+    screen_put(state->screen, x, y, text, CONSOLE_COLOR_NORMAL);
 }
 
 void print_colored_at(UIState* state, int x, int y, const char* text, WORD color) {
-    set_console_cursor_position(state, x, y);
-    set_console_color(state, color);
-    printf("%s", text);
-    set_console_color(state, CONSOLE_COLOR_NORMAL);
+    screen_put(state->screen, x, y, text, color);
 }
 
 int getch(void) {
-    return _getch();
+    return terminal_read_key();
 }
 
 void draw_header(UIState* state, const char* title) {
@@ -152,118 +226,263 @@ void draw_header(UIState* state, const char* title) {
     print_colored_at(state, center_x, 0, header, CONSOLE_COLOR_HEADER);
     
     // Draw separator line
-    for (int i = 0; i < state->console_width; i++) {
-        print_colored_at(state, i, 1, "-", CONSOLE_COLOR_HEADER);
-    }
+    screen_fill(state->screen, 0, 1, state->console_width, '-', CONSOLE_COLOR_HEADER);
 }
 
 void draw_footer(UIState* state, UIMode mode) {
     int footer_y = state->console_height - 2;
     
     // Draw separator line
-    for (int i = 0; i < state->console_width; i++) {
-        print_colored_at(state, i, footer_y, "-", CONSOLE_COLOR_HEADER);
-    }
+    screen_fill(state->screen, 0, footer_y, state->console_width, '-', CONSOLE_COLOR_HEADER);
     
-    const char* help_text = "";
+    char help_text[256];
+    char filters[128];
     switch (mode) {
         case MODE_TABLE:
-            help_text = "Arrow keys: Navigate | Enter: View release | X: Exit";
+            if (is_filtered(state)) {
+                format_filters(state, filters, sizeof(filters));
+                snprintf(help_text, sizeof(help_text), "Filter: %s (%d of %d) | /: Edit | P/W/R: Facets | Esc: Clear | 1-5: Sort | X: Exit",
+                         filters, state->view.count, state->releases->count);
+            } else {
+                snprintf(help_text, sizeof(help_text), "Arrows/PgUp/PgDn: Navigate | :: Go to | /: Search | P/W/R: Pre/Win/7d | 1-5: Sort | Enter: View | X: Exit");
+            }
+            break;
+        case MODE_SEARCH:
+            snprintf(help_text, sizeof(help_text), "Search: %s_ (%d of %d) | Enter: Done | Esc: Clear",
+                     state->search, get_row_count(state), state->releases->count);
+            break;
+        case MODE_GOTO:
+            snprintf(help_text, sizeof(help_text), "Go to row: %s_ (of %d) | Enter: Go | Esc: Cancel",
+                     state->jump, state->total_rows);
             break;
         case MODE_RELEASE_PAGE:
-            help_text = "Arrow keys: Scroll | Esc: Back to table | X: Exit";
+            snprintf(help_text, sizeof(help_text), "Arrow keys: Scroll | Esc: Back to table | X: Exit");
             break;
         default:
-            help_text = "X: Exit";
+            snprintf(help_text, sizeof(help_text), "X: Exit");
             break;
     }
     
-    print_at(state, 2, footer_y + 1, help_text);
+    // Pad so a shorter help text wipes the previous one
+    char line[512];
+    int width = state->console_width - 4;
+    if (width > (int)sizeof(line) - 1) width = (int)sizeof(line) - 1;
+    if (width < 0) width = 0;
+    snprintf(line, sizeof(line), "%-*.*s", width, width, help_text);
+    print_at(state, 2, footer_y + 1, line);
+    
+    // Connection reuse: handshakes should stay flat while requests grow
+    if (mode == MODE_TABLE || mode == MODE_SEARCH || mode == MODE_GOTO) {
+        HttpPoolStats stats;
+        char stats_text[128];
+        http_pool_get_stats(&stats);
+        snprintf(stats_text, sizeof(stats_text), "Conns: %d | Requests: %ld | Handshakes: %ld",
+                 stats.connection_count, stats.total_requests, stats.total_handshakes);
+        int stats_x = state->console_width - (int)strlen(stats_text) - 2;
+        if (stats_x > (int)strlen(help_text) + 4) {
+            print_at(state, stats_x, footer_y + 1, stats_text);
+        }
+    }
 }
 
-void draw_table_row(UIState* state, int row, Release* release, bool selected) {
-    char line[1024];
-    memset(line, 0, sizeof(line)); // Clear the buffer
-    WORD color = selected ? CONSOLE_COLOR_SELECTED : CONSOLE_COLOR_NORMAL;
-    
-    
+static void format_clock(time_t t, char* buffer, size_t size) {
+    struct tm* tm_info = localtime(&t);
+    if (tm_info) {
+        strftime(buffer, size, "%H:%M:%S", tm_info);
+    } else {
+        snprintf(buffer, size, "--:--:--");
+    }
+}
+
+// Rate-limit budget and projected completion, on the row between header and table
+void draw_status_line(UIState* state) {
+    SchedulerStatus status;
+    char text[256];
+    char clock[16];
+    int len = 0;
+
+    scheduler_get_status(&status);
+
+    if (status.limit >= 0) {
+        len += snprintf(text + len, sizeof(text) - len, "Rate limit: %ld/%ld",
+                        status.remaining, status.limit);
+        if (status.reset_at > 0) {
+            format_clock(status.reset_at, clock, sizeof(clock));
+            len += snprintf(text + len, sizeof(text) - len, " (resets %s)", clock);
+        }
+    } else {
+        len += snprintf(text + len, sizeof(text) - len, "Rate limit: unknown");
+    }
+
+    if (status.pending > 0) {
+        len += snprintf(text + len, sizeof(text) - len, " | Pending: %d", status.pending);
+        if (status.blocked_until > 0) {
+            format_clock(status.blocked_until, clock, sizeof(clock));
+            len += snprintf(text + len, sizeof(text) - len, " | Throttled until %s", clock);
+        }
+        if (status.projected_completion > 0) {
+            format_clock(status.projected_completion, clock, sizeof(clock));
+            len += snprintf(text + len, sizeof(text) - len, " | Done ~%s", clock);
+        }
+    }
+    if (status.retries > 0) {
+        snprintf(text + len, sizeof(text) - len, " | Retries: %d", status.retries);
+    }
+
+    // Pad to the full width so a shorter line wipes the previous one
+    char line[512];
+    int width = state->console_width - 2;
+    if (width > (int)sizeof(line) - 1) width = (int)sizeof(line) - 1;
+    if (width < 0) width = 0;
+    snprintf(line, sizeof(line), "%-*.*s", width, width, text);
+    print_at(state, 1, 2, line);
+
+    state->status_drawn = GetTickCount();
+    state->status_live = status.pending > 0;
+}
+
+// One column per asset platform: its label when the release has assets
+// for it, blank otherwise. A mask of ~0u gives the header.
+static void format_platforms(unsigned int platforms, char* out, size_t size) {
+    size_t len = 0;
+    out[0] = '\0';
     
-    // Format: Owner/Repo | Tag | Time | Prerelease | Windows Assets
+    for (int i = 0; i < ASSET_CLASS_COUNT; i++) {
+        const char* label = asset_class_label(i);
+        int written = snprintf(out + len, size - len, "%s%-*s", i ? " " : "",
+                               (int)strlen(label), (platforms & (1u << i)) ? label : "");
+        if (written < 0 || (size_t)written >= size - len) break;
+        len += written;
+    }
+}
+
+// Format: Owner/Repo | Tag | Time | Prerelease | Asset platforms, cut to
+// the table width
+static void format_table_row(UIState* state, TableRow* row, int id, time_t now) {
+    const Release* release = get_release(state->releases, id);
     char repo_full[64];
-    snprintf(repo_full, sizeof(repo_full), "%s/%s", release->owner, release->repo);
+    snprintf(repo_full, sizeof(repo_full), "%s/%s",
+             get_interned_string(release->owner), get_interned_string(release->repo));
 
-    if (strcmp(release->tag_name, "None") == 0) {
-        snprintf(line, sizeof(line), "%-45s | %-15s | %-14s | %-4s | %s",
+    row->id = id;
+    if (release->flags & RELEASE_PLACEHOLDER) {
+        snprintf(row->line, sizeof(row->line), "%-45s | %-15s | %-14s | %-6s | %s",
                  repo_full, "", "", "None", "");
+        row->expires = now + 86400;
     } else {
-        snprintf(line, sizeof(line), "%-45s | %-15s | %-14s | %-4s | %s",
-                 repo_full, release->tag_name, release->time_difference,
-                 release->prerelease ? "Pre" : "",
-                 release->has_windows_assets ? "Yes" : "No");
+        char age[MAX_TIME_DIFF_LENGTH];
+        char platforms[64];
+        format_release_age(release->created_at, age, sizeof(age));
+        format_platforms(release->platforms, platforms, sizeof(platforms));
+        snprintf(row->line, sizeof(row->line), "%-45s | %-15s | %-14s | %-6s | %s",
+                 repo_full, get_interned_string(release->tag), age,
+                 (release->flags & RELEASE_PRERELEASE) ? "Pre" : "", platforms);
+        row->expires = next_age_change(release->created_at, now);
     }
-    
-    // Truncate if too long
-    if (strlen(line) > state->console_width - 2) {
-        line[state->console_width - 2] = '\0';
+
+    // Count cells rather than bytes: names may be UTF-8
+    int width = state->console_width - 2;
+    int cells = 0;
+    char* p = row->line;
+    for (; *p && cells < width; p++) {
+        if (((unsigned char)*p & 0xC0) != 0x80) cells++;
+    }
+    while (((unsigned char)*p & 0xC0) == 0x80) p++;
+    *p = '\0';
+    row->cells = cells;
+}
+
+// Formatted row for a record, from the cache unless its age has moved on
+static const TableRow* get_table_row(UIState* state, int id) {
+    TableRow* row = &state->row_cache[id & state->row_cache_mask];
+    time_t now = time(NULL);
+
+    if (row->id != id || now >= row->expires) format_table_row(state, row, id, now);
+    if (row->expires < state->ages_expire) state->ages_expire = row->expires;
+    return row;
+}
+
+void draw_table_row(UIState* state, int row, int release_id, bool selected) {
+    const TableRow* formatted = get_table_row(state, release_id);
+    WORD color = selected ? CONSOLE_COLOR_SELECTED : CONSOLE_COLOR_NORMAL;
+
+    print_colored_at(state, 1, row + 4, formatted->line, color);
+    screen_fill(state->screen, 1 + formatted->cells, row + 4,
+                state->console_width - 2 - formatted->cells, ' ', CONSOLE_COLOR_NORMAL);
+}
+
+// Redraw the visible rows once the earliest age among them has moved on,
+// e.g. from "59min ago" to "1h ago", so a session left open stays
+// accurate. Only expired rows are formatted again, and the Screen sends
+// only the cells that changed. Does nothing until then.
+void refresh_ages(UIState* state) {
+    time_t now = time(NULL);
+    if (now < state->ages_expire) return;
+
+    // Nothing shown changes sooner than a day from now unless a row says so
+    state->ages_expire = now + 86400;
+    int row_count = get_row_count(state);
+    for (int i = 0; i < state->visible_rows && state->table_start_row + i < row_count; i++) {
+        int row = state->table_start_row + i;
+        draw_table_row(state, i, get_row_release_id(state, row), row + 1 == state->selected_row);
     }
-    
-    // Clear the line first
-    char clear_line[1024];
-    memset(clear_line, ' ', state->console_width - 2);
-    clear_line[state->console_width - 2] = '\0';
-    print_at(state, 1, row + 4, clear_line);
-    
-    // Then print the actual content
-    print_colored_at(state, 1, row + 4, line, color);
 }
 
 void draw_table(UIState* state) {
-    EnterCriticalSection(&state->releases->mutex);
-    
-    // Draw table header
-    print_colored_at(state, 1, 3, "Repository                                    | Tag             | Time           | Type | Windows", CONSOLE_COLOR_HEADER);
+    // Draw table header, marking the sorted column with its direction
+    char platforms[64];
+    char labels[SORT_FIELD_COUNT][72];
+    char header[SORT_FIELD_COUNT * 72 + 64];  // Every label, padding and separators
+    format_platforms(~0u, platforms, sizeof(platforms));
+    const char* names[SORT_FIELD_COUNT] = { "Repository", "Tag", "Time", "Type", platforms };
+    for (int i = 0; i < SORT_FIELD_COUNT; i++) {
+        const char* mark = (i != (int)state->sort_field) ? "" : state->sort_descending ? " v" : " ^";
+        snprintf(labels[i], sizeof(labels[i]), "%s%s", names[i], mark);
+    }
+    snprintf(header, sizeof(header), "%-45s | %-15s | %-14s | %-6s | %s",
+             labels[0], labels[1], labels[2], labels[3], labels[4]);
+    print_colored_at(state, 1, 3, header, CONSOLE_COLOR_HEADER);
     
-    // Draw releases
+    // Only the rows on screen are looked at, however long the table is
     int visible_count = 0;
-    for (int i = state->table_start_row; i < state->releases->count && visible_count < state->visible_rows; i++) {
+    int row_count = get_row_count(state);
+    for (int i = state->table_start_row; i < row_count && visible_count < state->visible_rows; i++) {
         bool selected = (i + 1 == state->selected_row);
-        draw_table_row(state, visible_count, &state->releases->releases[i], selected);
+        draw_table_row(state, visible_count, get_row_release_id(state, i), selected);
         visible_count++;
     }
     
     // Clear remaining lines in the table area
     for (int i = visible_count; i < state->visible_rows; i++) {
-        char empty_line[512];
-        memset(empty_line, ' ', state->console_width - 2);
-        empty_line[state->console_width - 2] = '\0';
-        print_at(state, 1, i + 4, empty_line);
+        screen_fill(state->screen, 1, i + 4, state->console_width - 2, ' ', CONSOLE_COLOR_NORMAL);
     }
 
     // Clear any lines below the table and above the footer
     for (int i = state->visible_rows + 4; i < state->console_height - 2; i++) {
-        char empty_line[512];
-        memset(empty_line, ' ', state->console_width);
-        empty_line[state->console_width] = '\0';
-        print_at(state, 0, i, empty_line);
+        screen_fill(state->screen, 0, i, state->console_width, ' ', CONSOLE_COLOR_NORMAL);
     }
     
-    state->total_rows = state->releases->count;
-    LeaveCriticalSection(&state->releases->mutex);
+    state->total_rows = row_count;
 }
 
 void update_display(UIState* state) {
-    static UIMode last_mode = -1;
+    static UIMode last_screen = -1;
 
-    if (state->current_mode != last_mode) {
+    // Searching keeps the table on screen, so entering it clears nothing
+    UIMode screen = shows_table(state) ? MODE_TABLE : state->current_mode;
+    if (screen != last_screen) {
         clear_console(state);
-        last_mode = state->current_mode;
+        last_screen = screen;
     }
     
     switch (state->current_mode) {
         case MODE_TABLE:
+        case MODE_SEARCH:
+        case MODE_GOTO:
             draw_header(state, "GitHub Release Monitor");
+            draw_status_line(state);
             draw_table(state);
-            draw_footer(state, MODE_TABLE);
+            draw_footer(state, state->current_mode);
             break;
         case MODE_RELEASE_PAGE:
             // Release page display is handled by display_release_page()
@@ -273,8 +492,8 @@ void update_display(UIState* state) {
             break;
     }
     
-    // Force flush
-    fflush(stdout);
+    // Send the frame
+    flush_screen(state->screen);
 }
 
 void center_text(UIState* state, int row, const char* text) {
@@ -288,29 +507,59 @@ void set_loading_message(UIState* state, int row, const char* owner, const char*
     center_text(state, row, message);
 }
 
+// Arrow and paging keys, by the scan code that follows the KEY_EXTENDED prefix
+static void move_selection(UIState* state, int key) {
+    switch (key) {
+        case KEY_UP:
+            select_row(state, state->selected_row - 2);
+            break;
+            
+        case KEY_DOWN:
+            if (state->selected_row < state->total_rows) select_row(state, state->selected_row);
+            break;
+            
+        case KEY_PGUP:
+            page_table(state, -1);
+            break;
+            
+        case KEY_PGDN:
+            page_table(state, 1);
+            break;
+            
+        case KEY_HOME:
+            select_row(state, 0);
+            break;
+            
+        case KEY_END:
+            select_row(state, state->total_rows - 1);
+            break;
+    }
+}
+
 void handle_table_input(UIState* state, int ch) {
     int previous_selected_row = state->selected_row;
     int previous_table_start_row = state->table_start_row;
 
+    // Scan codes double as letters (KEY_UP is 'H', KEY_HOME 'G'), so they
+    // only mean keys right after the prefix
+    if (ch == 0 || ch == KEY_EXTENDED) {
+        move_selection(state, getch());
+        ch = KEY_NONE;
+    }
+
     switch (ch) {
-        case KEY_UP: // Up arrow (Windows)
         case 'k':
-            if (state->selected_row > 1) {
-                state->selected_row--;
-                if (state->selected_row <= state->table_start_row) {
-                    state->table_start_row--;
-                }
-            }
+            move_selection(state, KEY_UP);
             break;
             
-        case KEY_DOWN: // Down arrow (Windows)
         case 'j':
-            if (state->selected_row < state->total_rows) {
-                state->selected_row++;
-                if (state->selected_row > state->table_start_row + state->visible_rows) {
-                    state->table_start_row++;
-                }
-            }
+            move_selection(state, KEY_DOWN);
+            break;
+            
+        case ':':
+            state->jump_length = 0;
+            state->jump[0] = '\0';
+            state->current_mode = MODE_GOTO;
             break;
             
         case KEY_ENTER: // Enter
@@ -318,37 +567,148 @@ void handle_table_input(UIState* state, int ch) {
                 state->current_mode = MODE_RELEASE_PAGE;
             }
             break;
+            
+        case '/':
+            state->current_mode = MODE_SEARCH;
+            break;
+            
+        case KEY_ESC:
+            if (is_filtered(state)) {
+                state->search[0] = '\0';
+                state->search_length = 0;
+                state->facets = 0;
+                apply_filters(state);
+                draw_table(state);
+            }
+            break;
+            
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+            sort_table(state, (SortField)(ch - '1'));
+            draw_table(state);
+            break;
+            
+        case 'p':
+        case 'P':
+            toggle_facet(state, FACET_PRERELEASE);
+            draw_table(state);
+            break;
+            
+        case 'w':
+        case 'W':
+            toggle_facet(state, FACET_WINDOWS);
+            draw_table(state);
+            break;
+            
+        case 'r':
+        case 'R':
+            toggle_facet(state, FACET_RECENT);
+            draw_table(state);
+            break;
     }
     
-    if (state->current_mode == MODE_TABLE) { // Only update display if still in table mode
+    if (state->current_mode != MODE_RELEASE_PAGE) { // Only update display if still showing the table
         if (previous_table_start_row != state->table_start_row) {
             // Table scrolled, redraw entire table
             draw_table(state);
         } else if (previous_selected_row != state->selected_row) {
             // Only selection changed, redraw affected rows
-            EnterCriticalSection(&state->releases->mutex);
             // Redraw previously selected row as unselected
             if (previous_selected_row > 0 && previous_selected_row <= state->total_rows) {
                 int row_index = previous_selected_row - 1;
                 if (row_index >= state->table_start_row && row_index < state->table_start_row + state->visible_rows) {
-                    draw_table_row(state, row_index - state->table_start_row, &state->releases->releases[row_index], false);
+                    draw_table_row(state, row_index - state->table_start_row,
+                                   get_row_release_id(state, row_index), false);
                 }
             }
             // Redraw newly selected row as selected
             if (state->selected_row > 0 && state->selected_row <= state->total_rows) {
                 int row_index = state->selected_row - 1;
                 if (row_index >= state->table_start_row && row_index < state->table_start_row + state->visible_rows) {
-                    draw_table_row(state, row_index - state->table_start_row, &state->releases->releases[row_index], true);
+                    draw_table_row(state, row_index - state->table_start_row,
+                                   get_row_release_id(state, row_index), true);
                 }
             }
-            LeaveCriticalSection(&state->releases->mutex);
         }
         // Always redraw footer to update help text if mode changes
-        draw_footer(state, MODE_TABLE);
-        fflush(stdout);
+        draw_footer(state, state->current_mode);
+        flush_screen(state->screen);
     }
 }
 
+// Typing after '/' narrows the table with every keystroke. Arrow and
+// paging keys still move the selection; Enter keeps the filter, Esc drops it.
+void handle_search_input(UIState* state, int ch) {
+    if (ch == 0 || ch == KEY_EXTENDED) {
+        handle_table_input(state, ch);
+        return;
+    }
+    
+    switch (ch) {
+        case KEY_ENTER:
+            state->current_mode = MODE_TABLE;
+            draw_footer(state, MODE_TABLE);
+            flush_screen(state->screen);
+            return;
+            
+        case KEY_ESC:
+            state->search_length = 0;
+            state->current_mode = MODE_TABLE;
+            break;
+            
+        case KEY_BACKSPACE:
+            if (state->search_length == 0) return;
+            state->search_length--;
+            break;
+            
+        default:
+            if (ch < 32 || ch > 126 || state->search_length >= MAX_SEARCH_LENGTH - 1) return;
+            state->search[state->search_length++] = (char)ch;
+            break;
+    }
+    state->search[state->search_length] = '\0';
+    
+    // A new query starts from its best match
+    state->selected_row = 1;
+    state->table_start_row = 0;
+    apply_filters(state);
+    draw_table(state);
+    draw_footer(state, state->current_mode);
+    flush_screen(state->screen);
+}
+
+// Digits after ':' name a row, counted from 1 as in the filter count;
+// Enter jumps there, Esc leaves the selection where it was
+void handle_goto_input(UIState* state, int ch) {
+    switch (ch) {
+        case KEY_ENTER:
+            if (state->jump_length > 0) select_row(state, atoi(state->jump) - 1);
+            state->current_mode = MODE_TABLE;
+            draw_table(state);
+            break;
+            
+        case KEY_ESC:
+            state->current_mode = MODE_TABLE;
+            break;
+            
+        case KEY_BACKSPACE:
+            if (state->jump_length == 0) return;
+            state->jump[--state->jump_length] = '\0';
+            break;
+            
+        default:
+            if (ch < '0' || ch > '9' || state->jump_length >= MAX_JUMP_LENGTH - 1) return;
+            state->jump[state->jump_length++] = (char)ch;
+            state->jump[state->jump_length] = '\0';
+            break;
+    }
+    draw_footer(state, state->current_mode);
+    flush_screen(state->screen);
+}
+
 void handle_input(UIState* state) {
     int ch = getch();
     
@@ -356,6 +716,12 @@ void handle_input(UIState* state) {
         case MODE_TABLE:
             handle_table_input(state, ch);
             break;
+        case MODE_SEARCH:
+            handle_search_input(state, ch);
+            break;
+        case MODE_GOTO:
+            handle_goto_input(state, ch);
+            break;
         case MODE_RELEASE_PAGE:
             // Handle release page input
             if (ch == 27) { // Escape
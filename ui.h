@@ -1,9 +1,12 @@
 #ifndef UI_H
 #define UI_H
 
-#include <Windows.h>
+#include "platform.h"
 #include "requests.h"
 #include "config.h"
+#include "release_search.h"
+#include "screen.h"
+#include "terminal.h"
 
 // Console colors
 #define CONSOLE_COLOR_NORMAL    (FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE)
@@ -12,24 +15,36 @@
 #define CONSOLE_COLOR_FRESH     (FOREGROUND_GREEN | FOREGROUND_INTENSITY)
 #define CONSOLE_COLOR_DAY_OLD   (FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY)
 #define CONSOLE_COLOR_ERROR     (FOREGROUND_RED | FOREGROUND_INTENSITY)
+#define CONSOLE_COLOR_EMPHASIS  (FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE | FOREGROUND_INTENSITY)
+#define CONSOLE_COLOR_CODE      (FOREGROUND_GREEN | FOREGROUND_BLUE)
+#define CONSOLE_COLOR_LINK      (FOREGROUND_BLUE | FOREGROUND_INTENSITY)
+#define CONSOLE_COLOR_BULLET    (FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY)
 
-// Key codes
-#define KEY_UP      72
-#define KEY_DOWN    80
-#define KEY_ENTER   13
-#define KEY_ESC     27
-#define KEY_CTRL_Q  17
+#define TABLE_LINE_SIZE 256     // A formatted table row; wider consoles get blanks
+#define TABLE_ROW_CACHE_MIN 64  // Row cache entries, rounded up to a power of two
+#define MAX_JUMP_LENGTH 10      // A ':' row number, terminator included
+
+// A table row as last formatted. Records never change once added, so the
+// line holds until the age text in it moves on. Cached per record, not
+// per screen row, so scrolling formats only the rows it brings in.
+typedef struct {
+    int id;                     // Record formatted here, -1 for none
+    time_t expires;             // See next_age_change
+    int cells;                  // Screen cells line takes up
+    char line[TABLE_LINE_SIZE];
+} TableRow;
 
 // UI modes
 typedef enum {
     MODE_TABLE,
     MODE_RELEASE_PAGE,
-    MODE_TAG_DROPDOWN
+    MODE_TAG_DROPDOWN,
+    MODE_SEARCH,        // Typing a filter after '/'; the table stays on screen
+    MODE_GOTO           // Typing a row number after ':'; likewise
 } UIMode;
 
-typedef struct {
-    HANDLE hConsole;
-    CONSOLE_SCREEN_BUFFER_INFO csbi;
+// Tagged: release_page.h refers to it as struct UIState
+typedef struct UIState {
     int console_width;
     int console_height;
     int selected_row;
@@ -39,33 +54,51 @@ typedef struct {
     UIMode current_mode;
     ReleaseCollection* releases;
     Config* config;
+    char search[MAX_SEARCH_LENGTH];     // Filter text, empty when not filtering
+    int search_length;
+    unsigned int facets;                // FACET_* bits the table is narrowed to
+    ReleaseView view;                   // Rows passing the search and facets
+    SortField sort_field;
+    bool sort_descending;
+    Screen* screen;                     // Everything drawn goes here first
+    TableRow* row_cache;                // Indexed by record id & row_cache_mask
+    int row_cache_mask;
+    time_t ages_expire;                 // Earliest expiry among visible rows
+    char jump[MAX_JUMP_LENGTH];         // Row number typed in MODE_GOTO
+    int jump_length;
+    DWORD status_drawn;                 // GetTickCount of the last status line
+    bool status_live;                   // It showed requests still outstanding
 } UIState;
 
 // Function declarations
-void init_ui(void);
+bool init_ui(void);
 void cleanup_ui(void);
 void setup_colors(void);
-void setup_windows_console(void);
 
 UIState* create_ui_state(Config* config, ReleaseCollection* releases);
 void free_ui_state(UIState* state);
 
 void draw_header(UIState* state, const char* title);
 void draw_footer(UIState* state, UIMode mode);
+void draw_status_line(UIState* state);
 void draw_table(UIState* state);
-void draw_table_row(UIState* state, int row, Release* release, bool selected);
+void draw_table_row(UIState* state, int row, int release_id, bool selected);
 void update_display(UIState* state);
+void refresh_ages(UIState* state);
 
 void handle_table_input(UIState* state, int ch);
+void handle_search_input(UIState* state, int ch);
+void handle_goto_input(UIState* state, int ch);
 void handle_input(UIState* state);
+void apply_filters(UIState* state);
+bool shows_table(const UIState* state);
+int get_selected_release_id(UIState* state);
 
 void center_text(UIState* state, int row, const char* text);
 void set_loading_message(UIState* state, int row, const char* owner, const char* repo);
 
 // Console utility functions
 void clear_console(UIState* state);
-void set_console_cursor_position(UIState* state, int x, int y);
-void set_console_color(UIState* state, WORD color);
 void print_at(UIState* state, int x, int y, const char* text);
 void print_colored_at(UIState* state, int x, int y, const char* text, WORD color);
 int getch(void);
@@ -2,7 +2,10 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <time.h>
-#include <Windows.h>
+#include "platform.h"
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
 
 const char* get_error_message(ErrorCode error) {
     switch (error) {
@@ -54,11 +57,21 @@ void log_message(const char* format, ...) {
 }
 
 bool file_exists(const char* path) {
+#ifdef _WIN32
     DWORD attributes = GetFileAttributes(path);
     return (attributes != INVALID_FILE_ATTRIBUTES && 
             !(attributes & FILE_ATTRIBUTE_DIRECTORY));
+#else
+    struct stat info;
+    return stat(path, &info) == 0 && !S_ISDIR(info.st_mode);
+#endif
 }
 
 void msleep(int milliseconds) {
+#ifdef _WIN32
     Sleep(milliseconds);
+#else
+    struct timespec delay = { milliseconds / 1000, (milliseconds % 1000) * 1000000L };
+    nanosleep(&delay, NULL);
+#endif
 }
\ No newline at end of file